@@ -0,0 +1,24 @@
+# Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+from conan import ConanFile
+
+
+class footprint(ConanFile):
+    python_requires = "libhal-bootstrap/[>=4.3.0 <5]"
+    python_requires_extend = "libhal-bootstrap.demo"
+
+    def requirements(self):
+        bootstrap = self.python_requires["libhal-bootstrap"]
+        bootstrap.module.add_demo_requirements(self)
+        self.requires("libhal-display/[1.0.2 || latest]")
@@ -0,0 +1,35 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <libhal-display/apa102.hpp>
+
+// A complete apa102 transmission built at compile time and sent from flash
+
+namespace {
+constexpr std::size_t pixel_count = FOOTPRINT_PIXEL_COUNT;
+constexpr auto stream = hal::display::make_apa102_stream([]() {
+  std::array<hal::display::rgb888, pixel_count> colors{};
+  for (std::size_t i = 0; i < colors.size(); i += 2) {
+    colors[i] = { 255, 0, 0 };
+  }
+  return colors;
+}());
+static_assert(sizeof(stream) == hal::display::apa102_stream_size(pixel_count));
+}  // namespace
+
+extern "C" void footprint_entry(hal::spi& p_spi)
+{
+  hal::display::apa102 driver(p_spi);
+  driver.update(stream);
+}
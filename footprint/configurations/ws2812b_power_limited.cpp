@@ -0,0 +1,36 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <libhal-display/power.hpp>
+#include <libhal-display/ws2812b.hpp>
+
+// A ws2812b frame in RAM, sent through the power limited update path
+
+namespace {
+constexpr std::size_t pixel_count = FOOTPRINT_PIXEL_COUNT;
+hal::display::ws2812b_spi_frame<pixel_count> frame{};
+static_assert(sizeof(frame) ==
+              hal::display::ws2812b_spi_frame_size(pixel_count));
+}  // namespace
+
+extern "C" void footprint_entry(hal::spi& p_spi)
+{
+  hal::display::ws2812b driver(p_spi);
+  hal::display::power_meter meter({ .budget_milliamps = 500 });
+  hal::display::ws2812b_spi_frame_view view(frame, meter);
+  for (std::size_t i = 0; i < view.pixel_count(); i++) {
+    view.set(i, { 255, 255, 255 });
+  }
+  driver.update(view);
+}
@@ -0,0 +1,67 @@
+# Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# Prints the .text, .rodata, unwind table, .data and .bss sizes of each
+# footprint image and writes them to a CSV file.
+#
+# Usage:
+#   cmake -DSIZE_TOOL=<size> -DIMAGES=<a.o|b.o> -DOUTPUT=<csv> -P report.cmake
+
+string(REPLACE "|" ";" IMAGES "${IMAGES}")
+set(csv "configuration,text,rodata,unwind,data,bss\n")
+set(table "")
+
+foreach(image ${IMAGES})
+  execute_process(
+    COMMAND ${SIZE_TOOL} -A ${image}
+    OUTPUT_VARIABLE sections
+    RESULT_VARIABLE result)
+  if(NOT result EQUAL 0)
+    message(FATAL_ERROR "Failed to read the sections of ${image}")
+  endif()
+
+  foreach(kind text rodata unwind data bss)
+    set(${kind} 0)
+  endforeach()
+
+  # With -ffunction-sections and -fdata-sections every symbol keeps its own
+  # section, such as .text._ZN3hal7display7ws2812b8transmit..., so sum each
+  # kind by prefix.
+  # Relocated read-only data, such as vtables, stays in flash and is counted
+  # as .rodata. The ARM exception unwind tables, .ARM.exidx and .ARM.extab,
+  # are also flash and are counted on their own as the cost of throwing.
+  string(REPLACE "\n" ";" lines "${sections}")
+  foreach(line ${lines})
+    if(line MATCHES "^\\.data\\.rel\\.ro[^ \t]*[ \t]+([0-9]+)")
+      math(EXPR rodata "${rodata} + ${CMAKE_MATCH_1}")
+    elseif(line MATCHES "^\\.ARM\\.ex(idx|tab)[^ \t]*[ \t]+([0-9]+)")
+      math(EXPR unwind "${unwind} + ${CMAKE_MATCH_2}")
+    elseif(line MATCHES "^\\.(text|rodata|data|bss)[^ \t]*[ \t]+([0-9]+)")
+      math(EXPR ${CMAKE_MATCH_1} "${${CMAKE_MATCH_1}} + ${CMAKE_MATCH_2}")
+    endif()
+  endforeach()
+
+  get_filename_component(name ${image} NAME_WE)
+  string(APPEND csv "${name},${text},${rodata},${unwind},${data},${bss}\n")
+
+  string(LENGTH "${name}" length)
+  math(EXPR padding "32 - ${length}")
+  string(REPEAT " " ${padding} spaces)
+  string(APPEND table
+    "${name}${spaces}${text}\t${rodata}\t${unwind}\t${data}\t${bss}\n")
+endforeach()
+
+file(WRITE ${OUTPUT} "${csv}")
+message(STATUS "Footprint in bytes, also written to ${OUTPUT}\n"
+  "configuration                   text\trodata\tunwind\tdata\tbss\n${table}")
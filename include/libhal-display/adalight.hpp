@@ -0,0 +1,237 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <libhal/serial.hpp>
+#include <libhal/units.hpp>
+
+#include "color.hpp"
+#include "frame_source.hpp"
+
+namespace hal::display {
+
+/**
+ * @brief Incrementally decodes the Adalight protocol one byte at a time
+ *
+ * Adalight is the protocol spoken by common PC ambient lighting software such
+ * as Prismatik, Hyperion and HyperHDR. Each frame is a 6 byte header followed
+ * by the red, green and blue value of every LED.
+ *
+ *   | Offset | Size | Contents                                      |
+ *   | ------ | ---- | --------------------------------------------- |
+ *   | 0      | 3    | Magic bytes "Ada"                             |
+ *   | 3      | 1    | High byte of the LED count minus one          |
+ *   | 4      | 1    | Low byte of the LED count minus one           |
+ *   | 5      | 1    | Checksum, high byte XOR low byte XOR 0x55     |
+ *   | 6      | 3*N  | Red, green and blue of each LED               |
+ *
+ * A header with a bad checksum is skipped and the decoder searches for the
+ * next magic bytes, so a receiver that starts listening mid-stream, or loses
+ * bytes, resynchronizes on the next frame.
+ */
+class adalight_decoder
+{
+public:
+  /// Result of decoding a single byte
+  struct event
+  {
+    /// Index of the pixel to set, only valid if `has_pixel` is true
+    std::size_t index = 0;
+    /// Color to set the pixel to, only valid if `has_pixel` is true
+    rgb888 color{};
+    /// Whether this byte completed a pixel
+    bool has_pixel = false;
+    /// Whether this byte completed a frame
+    bool frame_complete = false;
+  };
+
+  /**
+   * @brief Decode the next byte of the stream
+   *
+   * @param p_byte - next byte of the stream
+   * @return event - the pixel completed by this byte, if any
+   */
+  event feed(hal::byte p_byte);
+
+  /**
+   * @brief Discard any partially decoded frame and search for the next header
+   *
+   */
+  void reset();
+
+  /**
+   * @brief Get the number of headers rejected because of a bad checksum
+   *
+   * @return std::uint32_t - number of rejected headers since construction
+   */
+  [[nodiscard]] std::uint32_t rejected_headers() const
+  {
+    return m_rejected_headers;
+  }
+
+private:
+  enum class state : hal::byte
+  {
+    magic_a,
+    magic_d,
+    magic_a2,
+    count_high,
+    count_low,
+    checksum,
+    red,
+    green,
+    blue,
+  };
+
+  static state restart(hal::byte p_byte);
+  event feed_header(hal::byte p_byte);
+
+  rgb888 m_color{};
+  std::size_t m_index = 0;
+  std::size_t m_pixel_count = 0;
+  std::uint32_t m_rejected_headers = 0;
+  hal::byte m_count_high = 0;
+  hal::byte m_count_low = 0;
+  state m_state = state::magic_a;
+};
+
+/**
+ * @brief Receives live frames from a PC over a serial port using the Adalight
+ * protocol
+ *
+ * Bytes are read from the serial port in small chunks and each pixel is
+ * written straight into the device frame as soon as its last byte arrives,
+ * encoding it on the fly for ws2812b frames. No buffer the size of a frame is
+ * needed beyond the frame the driver already sends. Usage:
+ *
+ *     hal::display::adalight_receiver receiver(console);
+ *     receiver.announce();
+ *     while (true) {
+ *       receiver.poll(frame, driver);
+ *     }
+ */
+class adalight_receiver
+{
+public:
+  /// Number of bytes read from the serial port at a time
+  static constexpr std::size_t chunk_size = byte_pump::chunk_size;
+
+  /**
+   * @brief Construct a new Adalight receiver
+   *
+   * The serial port must already be configured to the baud rate the PC
+   * software uses.
+   *
+   * @param p_serial - serial port the frames are received over
+   */
+  adalight_receiver(hal::serial& p_serial);
+
+  /**
+   * @brief Send the "Ada\n" greeting PC software waits for before streaming
+   *
+   */
+  void announce();
+
+  /**
+   * @brief Decode available bytes into the frame until a frame completes
+   *
+   * Pixels beyond the end of `p_frame` are discarded.
+   *
+   * @tparam Frame - `apa102_frame_view`, `ws2812b_spi_frame_view` or
+   * `planar_frame_view`
+   * @param p_frame - frame to write the received pixels into
+   * @return true - a frame has been completed and is ready to send
+   * @return false - the serial port ran out of bytes before a frame completed
+   */
+  template<typename Frame>
+  bool poll(Frame p_frame)
+  {
+    return m_pump.drain(m_source, [this, p_frame](hal::byte p_byte) {
+      auto const event = m_decoder.feed(p_byte);
+
+      if (event.has_pixel && event.index < p_frame.pixel_count()) {
+        p_frame.set(event.index, event.color);
+      }
+
+      if (event.frame_complete) {
+        m_frames_received++;
+      }
+      return event.frame_complete;
+    });
+  }
+
+  /**
+   * @brief Decode available bytes into the frame and send the frame to the
+   * LEDs once it completes
+   *
+   * @tparam Frame - `apa102_frame_view`, `ws2812b_spi_frame_view` or
+   * `planar_frame_view`
+   * @tparam Driver - `apa102` or `ws2812b`
+   * @param p_frame - frame to write the received pixels into
+   * @param p_driver - driver to update with `p_frame` once it completes
+   * @return true - a frame has been completed and sent
+   * @return false - the serial port ran out of bytes before a frame completed
+   */
+  template<typename Frame, typename Driver>
+  bool poll(Frame p_frame, Driver& p_driver)
+  {
+    if (!poll(p_frame)) {
+      return false;
+    }
+    p_driver.update(p_frame);
+    return true;
+  }
+
+  /**
+   * @brief Get the number of bytes read from the serial port
+   *
+   * @return std::uint64_t - number of bytes read since construction
+   */
+  [[nodiscard]] std::uint64_t bytes_received() const
+  {
+    return m_pump.bytes_read();
+  }
+
+  /**
+   * @brief Get the number of frames completed
+   *
+   * @return std::uint32_t - number of frames completed since construction
+   */
+  [[nodiscard]] std::uint32_t frames_received() const
+  {
+    return m_frames_received;
+  }
+
+  /**
+   * @brief Get the decoder, for example to read its error counters
+   *
+   * @return adalight_decoder const& - the decoder of this receiver
+   */
+  [[nodiscard]] adalight_decoder const& decoder() const
+  {
+    return m_decoder;
+  }
+
+private:
+  hal::serial* m_serial;
+  serial_frame_source m_source;
+  adalight_decoder m_decoder{};
+  byte_pump m_pump{};
+  std::uint32_t m_frames_received = 0;
+};
+}  // namespace hal::display
@@ -0,0 +1,256 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+
+#include <libhal/units.hpp>
+
+#include "color.hpp"
+#include "frame_source.hpp"
+
+namespace hal::display {
+
+/**
+ * @brief Information at the start of every animation
+ *
+ * Animations are stored as a 10 byte header followed by frames. Multi-byte
+ * values are little endian.
+ *
+ *   | Offset | Size | Contents                                    |
+ *   | ------ | ---- | ------------------------------------------- |
+ *   | 0      | 4    | Magic bytes "LHAN"                          |
+ *   | 4      | 1    | Version, currently 1                        |
+ *   | 5      | 1    | Channels per pixel, 3 for RGB or 4 for RGBW |
+ *   | 6      | 2    | Pixels per frame                            |
+ *   | 8      | 2    | Time between frames in milliseconds         |
+ *
+ * Each frame starts with a type byte that selects how its pixels are stored.
+ * Pixels are stored as red, green, blue and, for RGBW animations, white.
+ *
+ * - `raw` (0x00): every pixel of the frame in order.
+ * - `run_length` (0x01): runs of one length byte holding the run length minus
+ *   one, followed by the pixel to repeat.
+ * - `delta` (0x02): pairs of a byte holding the number of pixels to leave
+ *   unchanged from the previous frame and a byte holding the number of pixels
+ *   that follow, followed by those pixels.
+ *
+ * Encoded runs continue until every pixel of the frame has been covered.
+ */
+struct animation_header
+{
+  /// Channels per pixel, 3 for RGB or 4 for RGBW
+  hal::byte channels = 3;
+  /// Pixels per frame
+  std::uint16_t pixel_count = 0;
+  /// Time between frames in milliseconds
+  std::uint16_t frame_period_ms = 0;
+};
+
+/**
+ * @brief Incrementally decodes an animation one byte at a time
+ *
+ * Holds no frame buffer of its own. Each decoded pixel, or run of pixels, is
+ * reported so it can be written straight into the device frame.
+ */
+class animation_decoder
+{
+public:
+  /// Size of the animation header in bytes
+  static constexpr std::size_t header_size = 10;
+
+  /// How the pixels of a frame are stored
+  enum class frame_type : hal::byte
+  {
+    raw = 0x00,
+    run_length = 0x01,
+    delta = 0x02,
+  };
+
+  /// Result of decoding a single byte
+  struct event
+  {
+    /// Index of the first pixel to set
+    std::size_t index = 0;
+    /// Number of pixels starting at `index` to set to `color`, 0 if none
+    std::size_t count = 0;
+    /// Color to set the pixels to
+    rgbw8888 color{};
+    /// Whether this byte completed a frame
+    bool frame_complete = false;
+  };
+
+  /**
+   * @brief Decode the next byte of the animation
+   *
+   * @param p_byte - next byte of the animation
+   * @return event - pixels decoded by this byte, if any
+   * @throws hal::io_error - if the header or a frame type is not valid. The
+   * rejected bytes are discarded and decoding continues with the next byte as
+   * the start of a new header or frame respectively.
+   */
+  event feed(hal::byte p_byte);
+
+  /**
+   * @brief Start decoding a new animation from its header
+   *
+   */
+  void reset();
+
+  /**
+   * @brief Whether the header has been fully decoded
+   *
+   * @return true - the header is available from `header()`
+   */
+  [[nodiscard]] bool has_header() const
+  {
+    return m_state != state::header;
+  }
+
+  /**
+   * @brief Get the animation header
+   *
+   * @return animation_header const& - the header, only valid once
+   * `has_header()` returns true
+   */
+  [[nodiscard]] animation_header const& header() const
+  {
+    return m_header;
+  }
+
+private:
+  enum class state : hal::byte
+  {
+    header,
+    frame_type,
+    raw_pixel,
+    run_length,
+    run_pixel,
+    delta_skip,
+    delta_length,
+    delta_pixel,
+  };
+
+  event feed_header(hal::byte p_byte);
+  event start_frame(hal::byte p_type);
+  event feed_pixel(hal::byte p_byte);
+  event emit(std::size_t p_count);
+  void end_run(event& p_event);
+
+  animation_header m_header{};
+  std::array<hal::byte, header_size> m_header_bytes{};
+  rgbw8888 m_color{};
+  std::size_t m_received = 0;
+  std::size_t m_index = 0;
+  std::size_t m_remaining = 0;
+  state m_state = state::header;
+  frame_type m_frame_type = frame_type::raw;
+};
+
+/**
+ * @brief Plays a pre-rendered animation from a frame source into a frame
+ *
+ * Bytes are pulled from the source in small chunks and decoded straight into
+ * the device frame, so no buffer the size of a frame is needed beyond the
+ * frame the driver already sends. Usage:
+ *
+ *     hal::display::animation_player player(source);
+ *     while (true) {
+ *       if (player.poll(frame)) {
+ *         driver.update(frame);
+ *         hal::delay(clock, milliseconds(player.header().frame_period_ms));
+ *       }
+ *     }
+ */
+class animation_player
+{
+public:
+  /// Number of bytes pulled from the source at a time
+  static constexpr std::size_t chunk_size = byte_pump::chunk_size;
+
+  /**
+   * @brief Construct a new animation player
+   *
+   * @param p_source - source of the animation bytes
+   */
+  animation_player(frame_source& p_source);
+
+  /**
+   * @brief Decode available bytes into the frame until a frame completes
+   *
+   * Pixels beyond the end of `p_frame` are discarded. Pixels of RGBW
+   * animations lose their white channel when written to RGB frames.
+   *
+   * @tparam Frame - `apa102_frame_view` or `ws2812b_spi_frame_view`
+   * @param p_frame - frame to decode the pixels into
+   * @return true - a frame has been completed and is ready to send
+   * @return false - the source ran out of bytes before a frame completed
+   * @throws hal::io_error - if the animation is malformed
+   */
+  template<typename Frame>
+  bool poll(Frame p_frame)
+  {
+    return m_pump.drain(*m_source, [this, p_frame](hal::byte p_byte) {
+      auto const event = m_decoder.feed(p_byte);
+
+      auto const end =
+        std::min(event.index + event.count, p_frame.pixel_count());
+      for (auto i = event.index; i < end; i++) {
+        write(p_frame, i, event.color);
+      }
+
+      return event.frame_complete;
+    });
+  }
+
+  /**
+   * @brief Start playing a new animation from its header
+   *
+   * Call after rewinding or replacing the contents of the source.
+   */
+  void reset();
+
+  /**
+   * @brief Get the animation header
+   *
+   * @return animation_header const& - the header, only valid once the first
+   * call to `poll()` has returned true
+   */
+  [[nodiscard]] animation_header const& header() const
+  {
+    return m_decoder.header();
+  }
+
+private:
+  template<typename Frame>
+  static void write(Frame p_frame, std::size_t p_index, rgbw8888 p_color)
+  {
+    if constexpr (std::is_same_v<typename Frame::color_type, rgbw8888>) {
+      p_frame.set(p_index, p_color);
+    } else {
+      p_frame.set(p_index, rgb888{ p_color.red, p_color.green, p_color.blue });
+    }
+  }
+
+  frame_source* m_source;
+  animation_decoder m_decoder{};
+  byte_pump m_pump{};
+};
+}  // namespace hal::display
@@ -15,14 +15,26 @@
 #pragma once
 
 #include <array>
+#include <cstddef>
+#include <cstdint>
 #include <span>
 
 #include <libhal-util/inert_drivers/inert_output_pin.hpp>
 #include <libhal-util/output_pin.hpp>
 #include <libhal-util/spi.hpp>
 
+#include "color.hpp"
+#include "planar.hpp"
+#include "power.hpp"
+
 namespace hal::display {
 
+/**
+ * @brief A single apa102 pixel as sent over SPI
+ *
+ * The brightness header followed by blue, green and red is shared by the
+ * APA102, SK9822 and HD107S, so all of them can be driven by `apa102`.
+ */
 struct apa102_pixel
 {
   /// bits 7 - 5 must be all 1's, otherwise undefined behavior
@@ -46,9 +58,352 @@ struct apa102_frame
   std::array<apa102_pixel, pixel_count> pixels;
 };
 
+/**
+ * @brief Calculates the number of bytes needed to store the pixel data for an
+ * apa102 strip
+ *
+ * Use this to size a caller provided buffer for `apa102_frame_view`.
+ *
+ * @param p_pixel_count - Number of pixels to control
+ * @return constexpr std::size_t - number of bytes needed for the pixel data
+ */
+constexpr std::size_t apa102_frame_size(std::size_t p_pixel_count)
+{
+  return p_pixel_count * sizeof(apa102_pixel);
+}
+
+/**
+ * @brief Calculates the number of 0xFF bytes sent after the pixels of an
+ * apa102 transmission
+ *
+ * Each pixel passes its data on half a clock late, so the end frame needs at
+ * least one clock for every two pixels. It is sent in words of 4 bytes, each
+ * covering 64 pixels, with at least one word.
+ *
+ * @param p_pixel_count - Number of pixels to control
+ * @return constexpr std::size_t - number of bytes in the end frame
+ */
+constexpr std::size_t apa102_end_frame_size(std::size_t p_pixel_count)
+{
+  auto const words = (p_pixel_count + 63U) / 64U;
+  return 4U * (words == 0 ? 1U : words);
+}
+
+/**
+ * @brief Calculates the number of bytes needed to store a complete apa102
+ * transmission, including the start and end frames
+ *
+ * @param p_pixel_count - Number of pixels to control
+ * @return constexpr std::size_t - number of bytes sent to update the strip
+ */
+constexpr std::size_t apa102_stream_size(std::size_t p_pixel_count)
+{
+  // 4 byte start frame of 0x00, then the pixels and the end frame of 0xFF
+  return 4 + apa102_frame_size(p_pixel_count) +
+         apa102_end_frame_size(p_pixel_count);
+}
+
+/**
+ * @brief Build a complete apa102 transmission of a fixed pattern at compile
+ * time
+ *
+ * Meant for patterns known when building, such as boot animations and error
+ * indicators. Declare the result `constexpr` (or `static constexpr` within a
+ * function) so the stream is placed in flash and costs no RAM, then send it
+ * with `apa102::update(stream)`.
+ *
+ *     static constexpr auto boot = hal::display::make_apa102_stream(
+ *       std::array<hal::display::rgb888, 3>{ { { 255, 0, 0 }, {}, {} } });
+ *     driver.update(boot);
+ *
+ * @tparam PixelCount - Number of pixels, set implicitly from `p_colors`
+ * @param p_colors - color of each pixel
+ * @param p_brightness - 5-bit global brightness of every pixel
+ * @return consteval std::array<hal::byte, apa102_stream_size(PixelCount)> -
+ * the start frame, every pixel and the end frame
+ */
+template<std::size_t PixelCount>
+consteval std::array<hal::byte, apa102_stream_size(PixelCount)>
+make_apa102_stream(std::array<rgb888, PixelCount> const& p_colors,
+                   hal::byte p_brightness = 0b1'1111)
+{
+  std::array<hal::byte, apa102_stream_size(PixelCount)> stream{};
+  auto const header =
+    static_cast<hal::byte>(0b1110'0000 | (p_brightness & 0b1'1111));
+  for (std::size_t i = 0; i < PixelCount; i++) {
+    auto* pixel = &stream[4 + (i * sizeof(apa102_pixel))];
+    pixel[0] = header;
+    pixel[1] = p_colors[i].blue;
+    pixel[2] = p_colors[i].green;
+    pixel[3] = p_colors[i].red;
+  }
+  auto const end_frame = stream.size() - apa102_end_frame_size(PixelCount);
+  for (std::size_t i = end_frame; i < stream.size(); i++) {
+    stream[i] = 0xFF;
+  }
+  return stream;
+}
+
+/**
+ * @brief Runtime sized view of apa102 pixels stored in a caller provided buffer
+ *
+ * Allows the number of pixels to be chosen at runtime, for example from a
+ * configuration value, while the storage comes from a static arena or linker
+ * section sized for the largest supported strip. The view does not own the
+ * pixels, thus the buffer must outlive the view.
+ *
+ * A view constructed with a `power_meter` reports every pixel it writes to
+ * the meter, including writes made by bulk writers such as the compositor,
+ * transitions and frame receivers, and `apa102::update()` keeps the frame
+ * within the budget of that meter. Writes made directly to `pixels()`, such as
+ * changes to the global brightness, are not tracked.
+ */
+class apa102_frame_view
+{
+public:
+  /// Color type accepted by `set()`
+  using color_type = rgb888;
+
+  /**
+   * @brief Construct a view over every pixel in the buffer
+   *
+   * @param p_pixels - buffer holding the pixels to control
+   */
+  constexpr apa102_frame_view(std::span<apa102_pixel> p_pixels)
+    : m_pixels(p_pixels)
+  {
+  }
+
+  /**
+   * @brief Construct a view over every pixel in the buffer that reports every
+   * write to a power meter
+   *
+   * @param p_pixels - buffer holding the pixels to control
+   * @param p_meter - meter tracking the current draw of `p_pixels`, must match
+   * their contents and outlive the view
+   */
+  constexpr apa102_frame_view(std::span<apa102_pixel> p_pixels,
+                              power_meter& p_meter)
+    : m_pixels(p_pixels)
+    , m_meter(&p_meter)
+  {
+  }
+
+  /**
+   * @brief Construct a view over the first `p_pixel_count` pixels of a buffer
+   *
+   * @param p_buffer - buffer holding at least `p_pixel_count` pixels
+   * @param p_pixel_count - Number of pixels to control
+   * @throws hal::argument_out_of_domain - if the buffer is too small to hold
+   * `p_pixel_count` pixels
+   */
+  apa102_frame_view(std::span<apa102_pixel> p_buffer,
+                    std::size_t p_pixel_count);
+
+  /**
+   * @brief Construct a view over the pixels of a compile time sized frame
+   *
+   * @tparam pixel_count - Number of pixels to control is set implicitly
+   * @param p_frame - frame to view
+   */
+  template<std::size_t pixel_count>
+  constexpr apa102_frame_view(apa102_frame<pixel_count>& p_frame)
+    : m_pixels(p_frame.pixels)
+  {
+  }
+
+  /**
+   * @brief Construct a view over the pixels of a compile time sized frame that
+   * reports every write to a power meter
+   *
+   * @tparam pixel_count - Number of pixels to control is set implicitly
+   * @param p_frame - frame to view
+   * @param p_meter - meter tracking the current draw of `p_frame`, must match
+   * its contents and outlive the view
+   */
+  template<std::size_t pixel_count>
+  constexpr apa102_frame_view(apa102_frame<pixel_count>& p_frame,
+                              power_meter& p_meter)
+    : m_pixels(p_frame.pixels)
+    , m_meter(&p_meter)
+  {
+  }
+
+  /**
+   * @brief Get the pixels within this view
+   *
+   * @return constexpr std::span<apa102_pixel> - the pixels within this view
+   */
+  [[nodiscard]] constexpr std::span<apa102_pixel> pixels() const
+  {
+    return m_pixels;
+  }
+
+  /**
+   * @brief Get the number of pixels within this view
+   *
+   * @return constexpr std::size_t - number of pixels within this view
+   */
+  [[nodiscard]] constexpr std::size_t pixel_count() const
+  {
+    return m_pixels.size();
+  }
+
+  /**
+   * @brief Get the power meter this view reports writes to
+   *
+   * @return constexpr power_meter* - the meter, or nullptr if writes are not
+   * tracked
+   */
+  [[nodiscard]] constexpr power_meter* meter() const
+  {
+    return m_meter;
+  }
+
+  /**
+   * @brief Set the color of a pixel, leaving its brightness unchanged
+   *
+   * @param p_index - index of the pixel, must be less than `pixel_count()`
+   * @param p_color - color to set the pixel to
+   */
+  constexpr void set(std::size_t p_index, rgb888 p_color) const
+  {
+    auto& pixel = m_pixels[p_index];
+    if (m_meter != nullptr) {
+      track(pixel, p_color);
+    }
+    pixel.blue = p_color.blue;
+    pixel.green = p_color.green;
+    pixel.red = p_color.red;
+  }
+
+  /**
+   * @brief Get the color of a pixel, ignoring its brightness
+   *
+   * @param p_index - index of the pixel, must be less than `pixel_count()`
+   * @return constexpr rgb888 - the color of the pixel
+   */
+  [[nodiscard]] constexpr rgb888 get(std::size_t p_index) const
+  {
+    auto const& pixel = m_pixels[p_index];
+    return { pixel.red, pixel.green, pixel.blue };
+  }
+
+  /**
+   * @brief Set every pixel to the same color, leaving brightness unchanged
+   *
+   * @param p_color - color to set every pixel to
+   */
+  constexpr void fill(rgb888 p_color) const
+  {
+    fill(0, pixel_count(), p_color);
+  }
+
+  /**
+   * @brief Set a range of pixels to the same color, leaving brightness
+   * unchanged
+   *
+   * @param p_first - index of the first pixel to set
+   * @param p_count - number of pixels to set, `p_first + p_count` must not
+   * exceed `pixel_count()`
+   * @param p_color - color to set the pixels to
+   */
+  constexpr void fill(std::size_t p_first,
+                      std::size_t p_count,
+                      rgb888 p_color) const
+  {
+    for (auto& pixel : m_pixels.subspan(p_first, p_count)) {
+      if (m_meter != nullptr) {
+        track(pixel, p_color);
+      }
+      pixel.blue = p_color.blue;
+      pixel.green = p_color.green;
+      pixel.red = p_color.red;
+    }
+  }
+
+  /**
+   * @brief Turn every pixel off, leaving brightness unchanged
+   *
+   */
+  constexpr void clear() const
+  {
+    fill(rgb888{});
+  }
+
+  /**
+   * @brief Set a range of pixels to a linear gradient between two colors,
+   * leaving brightness unchanged
+   *
+   * @param p_first - index of the first pixel to set
+   * @param p_count - number of pixels to set, `p_first + p_count` must not
+   * exceed `pixel_count()`
+   * @param p_from - color of the first pixel of the range
+   * @param p_to - color of the last pixel of the range
+   */
+  constexpr void gradient(std::size_t p_first,
+                          std::size_t p_count,
+                          rgb888 p_from,
+                          rgb888 p_to) const
+  {
+    for (std::size_t i = 0; i < p_count; i++) {
+      set(p_first + i, mix(p_from, p_to, gradient_amount(i, p_count)));
+    }
+  }
+
+private:
+  void track(apa102_pixel const& p_pixel, rgb888 p_color) const
+  {
+    hal::byte const brightness = p_pixel.brightness & 0b1'1111;
+    rgb888 const previous{ p_pixel.red, p_pixel.green, p_pixel.blue };
+    m_meter->exchange(power_meter::load(previous, brightness),
+                      power_meter::load(p_color, brightness));
+  }
+
+  std::span<apa102_pixel> m_pixels;
+  power_meter* m_meter = nullptr;
+};
+
+/**
+ * @brief Convert HSV colors directly into the pixels of an apa102 frame
+ *
+ * Converts as many pixels as both spans hold, leaving the brightness of each
+ * pixel unchanged.
+ *
+ * @param p_colors - colors to convert, one per pixel starting at pixel 0
+ * @param p_frame - frame to write the converted colors into
+ */
+void to_rgb(std::span<hsv const> p_colors, apa102_frame_view p_frame);
+
+/**
+ * @brief Convert HSL colors directly into the pixels of an apa102 frame
+ *
+ * Converts as many pixels as both spans hold, leaving the brightness of each
+ * pixel unchanged.
+ *
+ * @param p_colors - colors to convert, one per pixel starting at pixel 0
+ * @param p_frame - frame to write the converted colors into
+ */
+void to_rgb(std::span<hsl const> p_colors, apa102_frame_view p_frame);
+
+/**
+ * @brief Convert color temperatures directly into the pixels of an apa102
+ * frame
+ *
+ * Converts as many pixels as both spans hold, leaving the brightness of each
+ * pixel unchanged.
+ *
+ * @param p_kelvin - color temperatures in kelvin, one per pixel starting at
+ * pixel 0
+ * @param p_frame - frame to write the converted colors into
+ */
+void kelvin_to_rgb(std::span<std::uint16_t const> p_kelvin,
+                   apa102_frame_view p_frame);
+
 /**
  * @brief Driver for apa102 RGB LEDs
  *
+ * Also drives the pin compatible SK9822 and HD107S.
  */
 class apa102
 {
@@ -72,12 +427,54 @@ public:
   template<std::size_t pixel_count>
   void update(apa102_frame<pixel_count>& p_spi_frame)
   {
-    update(p_spi_frame.pixels);
+    update(apa102_frame_view(p_spi_frame));
   }
 
-private:
-  void update(std::span<apa102_pixel> p_data);
+  /**
+   * @brief Update the state of the LEDs from a runtime sized frame
+   *
+   * If the view reports its writes to a power meter, the frame is kept within
+   * the budget of that meter, see `update(p_frame, p_meter)`.
+   *
+   * @param p_frame - view of the pixels to send to control LEDs
+   */
+  void update(apa102_frame_view p_frame);
+
+  /**
+   * @brief Update the state of the LEDs from a planar working buffer
+   *
+   * The planes are interleaved in small batches as the data is sent. Pixels
+   * are sent at full brightness if the buffer has no brightness plane. A white
+   * plane is ignored.
+   *
+   * @param p_frame - planes holding the color of each pixel
+   */
+  void update(planar_frame_view p_frame);
+
+  /**
+   * @brief Send a complete, read-only apa102 transmission
+   *
+   * Sends the data as is without copying it, for example a stream built by
+   * `make_apa102_stream()` and stored in flash.
+   *
+   * @param p_stream - start frame, pixels and end frame, see
+   * `make_apa102_stream()`
+   */
+  void update(std::span<hal::byte const> p_stream);
+
+  /**
+   * @brief Update the state of the LEDs while staying within a current budget
+   *
+   * If the frame would draw more current than the budget of `p_meter`, every
+   * color channel is scaled by the same factor as the data is sent. The
+   * pixels stored in the frame are left unchanged.
+   *
+   * @param p_frame - view of the pixels to send to control LEDs
+   * @param p_meter - meter tracking the current draw of `p_frame`
+   */
+  void update(apa102_frame_view p_frame, power_meter const& p_meter);
 
+private:
   hal::spi* m_spi;
 
   hal::output_pin* m_chip_select;
@@ -0,0 +1,249 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <libhal/units.hpp>
+
+namespace hal::display {
+
+/**
+ * @brief 24-bit color with 8 bits per channel
+ *
+ */
+struct rgb888
+{
+  hal::byte red = 0;
+  hal::byte green = 0;
+  hal::byte blue = 0;
+
+  constexpr bool operator==(rgb888 const&) const = default;
+};
+
+/**
+ * @brief 32-bit color for pixels with a dedicated white LED
+ *
+ */
+struct rgbw8888
+{
+  hal::byte red = 0;
+  hal::byte green = 0;
+  hal::byte blue = 0;
+  hal::byte white = 0;
+
+  constexpr bool operator==(rgbw8888 const&) const = default;
+};
+
+/**
+ * @brief 48-bit color with 16 bits per channel for high bit depth LEDs
+ *
+ */
+struct rgb161616
+{
+  std::uint16_t red = 0;
+  std::uint16_t green = 0;
+  std::uint16_t blue = 0;
+
+  constexpr bool operator==(rgb161616 const&) const = default;
+};
+
+/**
+ * @brief 32-bit color with an alpha channel for layering
+ *
+ */
+struct rgba8888
+{
+  hal::byte red = 0;
+  hal::byte green = 0;
+  hal::byte blue = 0;
+  /// 0 is fully transparent and 255 is fully opaque
+  hal::byte alpha = 255;
+
+  constexpr bool operator==(rgba8888 const&) const = default;
+};
+
+/**
+ * @brief Color in the hue, saturation and value color space
+ *
+ */
+struct hsv
+{
+  /// Position on the color wheel where the full range of the integer maps to
+  /// 360 degrees. 0 is red, 21845 is green and 43690 is blue.
+  std::uint16_t hue = 0;
+  /// 0 is fully gray and 255 is fully saturated
+  hal::byte saturation = 0;
+  /// 0 is black and 255 is full brightness
+  hal::byte value = 0;
+};
+
+/**
+ * @brief Color in the hue, saturation and lightness color space
+ *
+ */
+struct hsl
+{
+  /// Position on the color wheel where the full range of the integer maps to
+  /// 360 degrees. 0 is red, 21845 is green and 43690 is blue.
+  std::uint16_t hue = 0;
+  /// 0 is fully gray and 255 is fully saturated
+  hal::byte saturation = 0;
+  /// 0 is black, 128 is the pure color and 255 is white
+  hal::byte lightness = 0;
+};
+
+/**
+ * @brief Multiply an 8-bit channel by an 8-bit factor
+ *
+ * Treats `p_factor` as a fraction of 255, so a factor of 255 returns the
+ * channel unchanged and 0 returns 0. The result is rounded to nearest.
+ *
+ * @param p_channel - channel value to scale
+ * @param p_factor - scale factor where 255 represents 1.0
+ * @return constexpr hal::byte - `p_channel * p_factor / 255` rounded
+ */
+constexpr hal::byte scale_channel(hal::byte p_channel, hal::byte p_factor)
+{
+  std::uint32_t const product = p_channel * p_factor + 128U;
+  return static_cast<hal::byte>((product + (product >> 8U)) >> 8U);
+}
+
+/**
+ * @brief Mix two 8-bit channel values
+ *
+ * @param p_from - value when `p_amount` is 0
+ * @param p_to - value when `p_amount` is 255
+ * @param p_amount - how far to move from `p_from` towards `p_to`, where 255
+ * represents 1.0
+ * @return constexpr hal::byte - the mixed value rounded to nearest
+ */
+constexpr hal::byte mix_channel(hal::byte p_from,
+                                hal::byte p_to,
+                                hal::byte p_amount)
+{
+  std::uint32_t const product =
+    p_from * (255U - p_amount) + p_to * p_amount + 128U;
+  return static_cast<hal::byte>((product + (product >> 8U)) >> 8U);
+}
+
+/**
+ * @brief Mix two colors channel by channel
+ *
+ * @param p_from - color when `p_amount` is 0
+ * @param p_to - color when `p_amount` is 255
+ * @param p_amount - how far to move from `p_from` towards `p_to`, where 255
+ * represents 1.0
+ * @return constexpr rgb888 - the mixed color
+ */
+constexpr rgb888 mix(rgb888 p_from, rgb888 p_to, hal::byte p_amount)
+{
+  return {
+    .red = mix_channel(p_from.red, p_to.red, p_amount),
+    .green = mix_channel(p_from.green, p_to.green, p_amount),
+    .blue = mix_channel(p_from.blue, p_to.blue, p_amount),
+  };
+}
+
+/**
+ * @brief Mix two colors with a white LED channel by channel
+ *
+ * @param p_from - color when `p_amount` is 0
+ * @param p_to - color when `p_amount` is 255
+ * @param p_amount - how far to move from `p_from` towards `p_to`, where 255
+ * represents 1.0
+ * @return constexpr rgbw8888 - the mixed color
+ */
+constexpr rgbw8888 mix(rgbw8888 p_from, rgbw8888 p_to, hal::byte p_amount)
+{
+  return {
+    .red = mix_channel(p_from.red, p_to.red, p_amount),
+    .green = mix_channel(p_from.green, p_to.green, p_amount),
+    .blue = mix_channel(p_from.blue, p_to.blue, p_amount),
+    .white = mix_channel(p_from.white, p_to.white, p_amount),
+  };
+}
+
+/**
+ * @brief Calculate how far along a gradient a pixel is
+ *
+ * @param p_index - position of the pixel within the gradient
+ * @param p_count - number of pixels in the gradient
+ * @return constexpr hal::byte - 0 for the first pixel and 255 for the last
+ */
+constexpr hal::byte gradient_amount(std::size_t p_index, std::size_t p_count)
+{
+  if (p_count < 2) {
+    return 0;
+  }
+  auto const last = p_count - 1;
+  return static_cast<hal::byte>((p_index * 255U + (last / 2U)) / last);
+}
+
+/**
+ * @brief Get the address of the pixel data a frame view refers to
+ *
+ * Two views of the same type show the same pixels when their addresses and
+ * pixel counts are equal.
+ *
+ * @tparam Frame - frame view type, set implicitly
+ * @param p_frame - view to get the pixel data address of
+ * @return void const* - address of the first byte of pixel data
+ */
+template<typename Frame>
+constexpr void const* pixel_address(Frame const& p_frame)
+{
+  if constexpr (requires { p_frame.data(); }) {
+    return p_frame.data().data();
+  } else if constexpr (requires { p_frame.pixels(); }) {
+    return p_frame.pixels().data();
+  } else {
+    return p_frame.red().data();
+  }
+}
+
+/**
+ * @brief Convert an HSV color to RGB using integer arithmetic only
+ *
+ * Each channel is within 2 counts of the floating point conversion.
+ *
+ * @param p_color - color to convert
+ * @return rgb888 - the converted color
+ */
+rgb888 to_rgb(hsv p_color);
+
+/**
+ * @brief Convert an HSL color to RGB using integer arithmetic only
+ *
+ * Each channel is within 2 counts of the floating point conversion.
+ *
+ * @param p_color - color to convert
+ * @return rgb888 - the converted color
+ */
+rgb888 to_rgb(hsl p_color);
+
+/**
+ * @brief Convert a black body color temperature to RGB
+ *
+ * Interpolates between precomputed points of Tanner Helland's curve fit,
+ * spaced evenly in kelvin below 6600K and evenly in mireds above it. Each
+ * channel is within 3 counts of the floating point fit.
+ *
+ * @param p_kelvin - color temperature in kelvin, clamped to 1000K to 40000K
+ * @return rgb888 - the converted color
+ */
+rgb888 kelvin_to_rgb(std::uint16_t p_kelvin);
+}  // namespace hal::display
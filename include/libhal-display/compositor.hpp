@@ -0,0 +1,427 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include <libhal/error.hpp>
+#include <libhal/units.hpp>
+
+#include "color.hpp"
+
+namespace hal::display {
+
+/**
+ * @brief How a layer is combined with the layers beneath it
+ *
+ */
+enum class blend_mode : hal::byte
+{
+  /// Paint over the layers beneath, weighted by alpha
+  normal,
+  /// Add to the layers beneath, saturating at full intensity
+  additive,
+  /// Keep the brighter of the layer and the layers beneath for each channel
+  maximum,
+};
+
+/**
+ * @brief A layer of pixels to composite
+ *
+ * Layer pixels map one to one onto frame pixels starting at pixel 0. Frame
+ * pixels beyond the end of a layer are left untouched by that layer.
+ */
+struct layer
+{
+  /// The pixels of the layer, must outlive any call to `composite()`
+  std::span<rgba8888 const> pixels{};
+  /// How the layer is combined with the layers beneath it
+  blend_mode mode = blend_mode::normal;
+  /// Opacity of the whole layer, multiplied with the alpha of each pixel
+  hal::byte opacity = 255;
+  /// The pixels and settings of the layer have not changed since the last
+  /// composite
+  bool is_static = false;
+  /// The layer has nothing to show, for example a notification that is not
+  /// active. Empty layers are skipped entirely.
+  bool is_empty = false;
+};
+
+/**
+ * @brief Pack a color into a word as 0x00RRGGBB for the blend kernels
+ *
+ * @param p_color - color to pack
+ * @return constexpr std::uint32_t - packed color
+ */
+constexpr std::uint32_t pack(rgb888 p_color)
+{
+  return (std::uint32_t{ p_color.red } << 16U) |
+         (std::uint32_t{ p_color.green } << 8U) | p_color.blue;
+}
+
+/**
+ * @brief Unpack a color packed by `pack()`
+ *
+ * @param p_packed - packed color
+ * @return constexpr rgb888 - unpacked color
+ */
+constexpr rgb888 unpack(std::uint32_t p_packed)
+{
+  return {
+    .red = static_cast<hal::byte>(p_packed >> 16U),
+    .green = static_cast<hal::byte>(p_packed >> 8U),
+    .blue = static_cast<hal::byte>(p_packed),
+  };
+}
+
+/**
+ * @brief Scale every channel of a packed color at once
+ *
+ * Red and blue are multiplied together in one word and green in another, with
+ * 16 bits per channel so the products never carry into a neighboring channel.
+ *
+ * @param p_packed - packed color
+ * @param p_alpha - scale factor where 256 represents 1.0
+ * @return constexpr std::uint32_t - packed scaled color
+ */
+constexpr std::uint32_t blend_scale(std::uint32_t p_packed,
+                                    std::uint32_t p_alpha)
+{
+  std::uint32_t const red_blue = ((p_packed & 0xFF00FFU) * p_alpha) >> 8U;
+  std::uint32_t const green = ((p_packed & 0x00FF00U) * p_alpha) >> 8U;
+  return (red_blue & 0xFF00FFU) | (green & 0x00FF00U);
+}
+
+/**
+ * @brief Paint a packed color over another, weighted by alpha
+ *
+ * @param p_destination - packed color beneath
+ * @param p_source - packed color on top
+ * @param p_alpha - weight of `p_source` where 256 represents 1.0
+ * @return constexpr std::uint32_t - packed blended color
+ */
+constexpr std::uint32_t blend_normal(std::uint32_t p_destination,
+                                     std::uint32_t p_source,
+                                     std::uint32_t p_alpha)
+{
+  std::uint32_t const inverse = 256U - p_alpha;
+  std::uint32_t const red_blue = ((p_destination & 0xFF00FFU) * inverse +
+                                  (p_source & 0xFF00FFU) * p_alpha) >>
+                                 8U;
+  std::uint32_t const green = ((p_destination & 0x00FF00U) * inverse +
+                               (p_source & 0x00FF00U) * p_alpha) >>
+                              8U;
+  return (red_blue & 0xFF00FFU) | (green & 0x00FF00U);
+}
+
+/**
+ * @brief Add a packed color to another, weighted by alpha and saturating each
+ * channel at 255
+ *
+ * @param p_destination - packed color beneath
+ * @param p_source - packed color on top
+ * @param p_alpha - weight of `p_source` where 256 represents 1.0
+ * @return constexpr std::uint32_t - packed blended color
+ */
+constexpr std::uint32_t blend_additive(std::uint32_t p_destination,
+                                       std::uint32_t p_source,
+                                       std::uint32_t p_alpha)
+{
+  constexpr std::uint32_t high_bits = 0x808080U;
+  constexpr std::uint32_t low_bits = 0x7F7F7FU;
+  std::uint32_t const source = blend_scale(p_source, p_alpha);
+  // Add the low 7 bits of each channel, then fold in the top bits by hand so
+  // no carry crosses into the neighboring channel.
+  std::uint32_t const low_sum =
+    (p_destination & low_bits) + (source & low_bits);
+  std::uint32_t const sum = low_sum ^ ((p_destination ^ source) & high_bits);
+  std::uint32_t const carry =
+    ((p_destination & source) | ((p_destination ^ source) & low_sum)) &
+    high_bits;
+  // Expand each carry bit into 0xFF for its channel
+  std::uint32_t const saturate = (carry >> 7U) * 0xFFU;
+  return sum | saturate;
+}
+
+/**
+ * @brief Keep the brighter of two packed colors for each channel
+ *
+ * @param p_destination - packed color beneath
+ * @param p_source - packed color on top
+ * @param p_alpha - weight of `p_source` where 256 represents 1.0
+ * @return constexpr std::uint32_t - packed blended color
+ */
+constexpr std::uint32_t blend_maximum(std::uint32_t p_destination,
+                                      std::uint32_t p_source,
+                                      std::uint32_t p_alpha)
+{
+  constexpr std::uint32_t high_bits = 0x808080U;
+  constexpr std::uint32_t low_bits = 0x7F7F7FU;
+  std::uint32_t const source = blend_scale(p_source, p_alpha);
+  // Bit 7 of each channel of `difference` is set when the low 7 bits of the
+  // destination are greater than or equal to those of the source. The top
+  // bits then decide the comparison when they differ.
+  std::uint32_t const difference =
+    (p_destination | high_bits) - (source & low_bits);
+  std::uint32_t const greater_or_equal =
+    ((p_destination & ~source) |
+     (~(p_destination ^ source) & difference)) &
+    high_bits;
+  std::uint32_t const mask = (greater_or_equal >> 7U) * 0xFFU;
+  return (p_destination & mask) | (source & ~mask & 0xFFFFFFU);
+}
+
+/**
+ * @brief Blends layers of pixels directly into a device frame
+ *
+ * Every frame pixel is computed in a single pass over the layers, starting
+ * from black and blending each layer on top of the previous in order, then
+ * written to the frame. No intermediate full frame buffers are needed.
+ *
+ * Static layers at the bottom of the stack, such as a background under a
+ * moving overlay, are only blended again when they change if the compositor is
+ * given a cache with one word per frame pixel. Without a cache they are
+ * blended on every composite. Usage:
+ *
+ *     std::array<std::uint32_t, 60> cache{};
+ *     hal::display::compositor mixer(cache);
+ *     mixer.composite(layers, hal::display::apa102_frame_view(frame));
+ *
+ * @tparam MaxLayers - Maximum number of non-empty layers blended at once
+ */
+template<std::size_t MaxLayers = 8>
+class compositor
+{
+public:
+  /// Maximum number of non-empty layers blended at once
+  static constexpr std::size_t max_layers = MaxLayers;
+
+  /**
+   * @brief Construct a compositor that blends every layer on every composite
+   *
+   */
+  constexpr compositor() = default;
+
+  /**
+   * @brief Construct a compositor that caches the blend of the static layers
+   * at the bottom of the stack
+   *
+   * @param p_cache - one word per frame pixel, must outlive the compositor.
+   * Frames with more pixels than the cache holds are composited without it.
+   */
+  constexpr compositor(std::span<std::uint32_t> p_cache)
+    : m_cache(p_cache)
+  {
+  }
+
+  /**
+   * @brief Blend the layers into the frame
+   *
+   * If every non-empty layer is static and this compositor was the last to
+   * write to the same frame from the same non-empty layers, with the same
+   * blend modes and opacities, the frame already holds the result and is left
+   * untouched. Emptying a layer or fading it to 0 opacity is enough to have it
+   * removed from the frame.
+   *
+   * @tparam Frame - `apa102_frame_view` or `ws2812b_spi_frame_view`
+   * @param p_layers - layers from bottom to top
+   * @param p_frame - frame to write the result into
+   * @return true - the frame was written
+   * @return false - the frame already held the result
+   * @throws hal::argument_out_of_domain - if more than `max_layers` layers are
+   * non-empty
+   */
+  template<typename Frame>
+  bool composite(std::span<layer const> p_layers, Frame p_frame)
+  {
+    std::array<layer const*, max_layers> active{};
+    std::size_t active_count = 0;
+    std::size_t static_count = 0;
+
+    for (auto const& current : p_layers) {
+      if (current.is_empty || current.opacity == 0) {
+        continue;
+      }
+      if (active_count == active.size()) {
+        throw hal::argument_out_of_domain(this);
+      }
+      if (current.is_static && static_count == active_count) {
+        static_count++;
+      }
+      active[active_count++] = &current;
+    }
+
+    auto const active_layers = std::span(active).first(active_count);
+    void const* const frame = pixel_address(p_frame);
+    if (static_count == active_count && m_up_to_date && m_frame == frame &&
+        m_frame_pixels == p_frame.pixel_count() &&
+        matches(active_layers, m_written, m_written_count)) {
+      return false;
+    }
+
+    std::size_t first_layer = 0;
+    bool const use_cache = static_count != 0 && p_frame.pixel_count() != 0 &&
+                           p_frame.pixel_count() <= m_cache.size();
+    if (use_cache) {
+      update_cache(active_layers.first(static_count), p_frame.pixel_count());
+      first_layer = static_count;
+    } else {
+      // The static layers may change before the cache is used again
+      m_cached_count = 0;
+    }
+
+    for (std::size_t i = 0; i < p_frame.pixel_count(); i++) {
+      std::uint32_t result = use_cache ? m_cache[i] : 0;
+      for (std::size_t j = first_layer; j < active_count; j++) {
+        result = blend_pixel(result, *active[j], i);
+      }
+      p_frame.set(i, unpack(result));
+    }
+
+    m_up_to_date = true;
+    m_frame = frame;
+    m_frame_pixels = p_frame.pixel_count();
+    record(active_layers, m_written, m_written_count);
+    return true;
+  }
+
+  /**
+   * @brief Force the next composite to blend and write every layer
+   *
+   * Call when the pixels of a static layer change, or when the frame was
+   * written by something other than this compositor. Adding, removing,
+   * reordering or fading layers is detected without it.
+   */
+  void invalidate()
+  {
+    m_up_to_date = false;
+    m_cached_count = 0;
+  }
+
+private:
+  /// Everything about a layer, other than its pixel values, that the result
+  /// of a composite depends on
+  struct layer_key
+  {
+    rgba8888 const* pixels = nullptr;
+    std::size_t size = 0;
+    blend_mode mode = blend_mode::normal;
+    hal::byte opacity = 0;
+
+    constexpr bool operator==(layer_key const&) const = default;
+  };
+
+  static constexpr layer_key key(layer const& p_layer)
+  {
+    return {
+      .pixels = p_layer.pixels.data(),
+      .size = p_layer.pixels.size(),
+      .mode = p_layer.mode,
+      .opacity = p_layer.opacity,
+    };
+  }
+
+  static constexpr bool matches(
+    std::span<layer const*> p_layers,
+    std::array<layer_key, max_layers> const& p_keys,
+    std::size_t p_key_count)
+  {
+    if (p_layers.size() != p_key_count) {
+      return false;
+    }
+    for (std::size_t j = 0; j < p_layers.size(); j++) {
+      if (key(*p_layers[j]) != p_keys[j]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  static constexpr void record(std::span<layer const*> p_layers,
+                               std::array<layer_key, max_layers>& p_keys,
+                               std::size_t& p_key_count)
+  {
+    for (std::size_t j = 0; j < p_layers.size(); j++) {
+      p_keys[j] = key(*p_layers[j]);
+    }
+    p_key_count = p_layers.size();
+  }
+
+  void update_cache(std::span<layer const*> p_layers, std::size_t p_count)
+  {
+    if (m_cached_pixels == p_count &&
+        matches(p_layers, m_cached, m_cached_count)) {
+      return;
+    }
+
+    for (std::size_t i = 0; i < p_count; i++) {
+      std::uint32_t result = 0;
+      for (auto const* current : p_layers) {
+        result = blend_pixel(result, *current, i);
+      }
+      m_cache[i] = result;
+    }
+    record(p_layers, m_cached, m_cached_count);
+    m_cached_pixels = p_count;
+  }
+
+  static constexpr std::uint32_t blend_pixel(std::uint32_t p_destination,
+                                             layer const& p_layer,
+                                             std::size_t p_index)
+  {
+    if (p_index >= p_layer.pixels.size()) {
+      return p_destination;
+    }
+    return blend(p_destination, p_layer, p_layer.pixels[p_index]);
+  }
+
+  static constexpr std::uint32_t blend(std::uint32_t p_destination,
+                                       layer const& p_layer,
+                                       rgba8888 p_pixel)
+  {
+    std::uint32_t const alpha = scale_channel(p_pixel.alpha, p_layer.opacity);
+    // Map 0 to 255 onto 0 to 256 so full alpha copies the source exactly
+    std::uint32_t const weight = alpha + (alpha >> 7U);
+    std::uint32_t const source =
+      pack({ p_pixel.red, p_pixel.green, p_pixel.blue });
+
+    switch (p_layer.mode) {
+      case blend_mode::additive:
+        return blend_additive(p_destination, source, weight);
+      case blend_mode::maximum:
+        return blend_maximum(p_destination, source, weight);
+      case blend_mode::normal:
+      default:
+        return blend_normal(p_destination, source, weight);
+    }
+  }
+
+  std::span<std::uint32_t> m_cache{};
+  // Static layers blended into the cache, from bottom to top
+  std::array<layer_key, max_layers> m_cached{};
+  std::size_t m_cached_count = 0;
+  std::size_t m_cached_pixels = 0;
+  // Frame written by the last composite
+  void const* m_frame = nullptr;
+  std::size_t m_frame_pixels = 0;
+  // Non-empty layers of the last composite, from bottom to top
+  std::array<layer_key, max_layers> m_written{};
+  std::size_t m_written_count = 0;
+  bool m_up_to_date = false;
+};
+}  // namespace hal::display
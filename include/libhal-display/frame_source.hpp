@@ -0,0 +1,175 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include <libhal/serial.hpp>
+#include <libhal/units.hpp>
+
+namespace hal::display {
+
+/**
+ * @brief Source of streamed frame data, such as a pre-rendered animation or
+ * live frames sent by a PC
+ *
+ * Implementations may return fewer bytes than requested, for example when a
+ * serial port has not yet received the rest of a frame.
+ */
+class frame_source
+{
+public:
+  /**
+   * @brief Read the next bytes of the stream
+   *
+   * @param p_buffer - buffer to fill with stream bytes
+   * @return std::span<hal::byte> - the portion of `p_buffer` that was filled.
+   * Empty if no bytes are currently available.
+   */
+  std::span<hal::byte> read(std::span<hal::byte> p_buffer)
+  {
+    return driver_read(p_buffer);
+  }
+
+  virtual ~frame_source() = default;
+
+private:
+  virtual std::span<hal::byte> driver_read(std::span<hal::byte> p_buffer) = 0;
+};
+
+/**
+ * @brief Reads a stream from a serial port
+ *
+ */
+class serial_frame_source : public frame_source
+{
+public:
+  /**
+   * @brief Construct a new serial frame source
+   *
+   * @param p_serial - serial port the stream is received over
+   */
+  serial_frame_source(hal::serial& p_serial);
+
+private:
+  std::span<hal::byte> driver_read(std::span<hal::byte> p_buffer) override;
+
+  hal::serial* m_serial;
+};
+
+/**
+ * @brief Reads an animation from memory
+ *
+ * Suitable for animations stored in flash, external memory mapped storage or,
+ * on Linux hosts, a memory mapped file.
+ */
+class memory_frame_source : public frame_source
+{
+public:
+  /**
+   * @brief Construct a new memory frame source
+   *
+   * @param p_animation - the complete animation, must outlive this object
+   */
+  memory_frame_source(std::span<hal::byte const> p_animation);
+
+  /**
+   * @brief Start reading from the beginning of the animation again
+   *
+   */
+  void rewind();
+
+private:
+  std::span<hal::byte> driver_read(std::span<hal::byte> p_buffer) override;
+
+  std::span<hal::byte const> m_animation;
+  std::size_t m_position = 0;
+};
+
+/**
+ * @brief Pulls bytes from a frame source in small chunks and hands them to a
+ * decoder one at a time
+ *
+ * Holds the chunk buffer and the position within it between calls, so a
+ * decoder can stop at the end of a frame and resume from the next byte of the
+ * same chunk on the following call.
+ */
+class byte_pump
+{
+public:
+  /// Number of bytes pulled from the source at a time
+  static constexpr std::size_t chunk_size = 64;
+
+  /**
+   * @brief Feed bytes to a consumer until it asks to stop or the source runs
+   * out of bytes
+   *
+   * @tparam Consumer - callable taking a `hal::byte` and returning a bool
+   * @param p_source - source to pull bytes from when the chunk is used up
+   * @param p_consume - called with each byte in order, returns true to stop
+   * after that byte
+   * @return true - `p_consume` asked to stop
+   * @return false - the source ran out of bytes
+   */
+  template<typename Consumer>
+  bool drain(frame_source& p_source, Consumer&& p_consume)
+  {
+    while (true) {
+      if (m_position == m_size) {
+        auto const received = p_source.read(m_chunk);
+        if (received.empty()) {
+          return false;
+        }
+        m_position = static_cast<std::size_t>(received.data() - m_chunk.data());
+        m_size = m_position + received.size();
+        m_bytes_read += received.size();
+      }
+
+      if (p_consume(m_chunk[m_position++])) {
+        return true;
+      }
+    }
+  }
+
+  /**
+   * @brief Drop any bytes pulled from the source but not yet consumed
+   *
+   */
+  void discard()
+  {
+    m_position = 0;
+    m_size = 0;
+  }
+
+  /**
+   * @brief Get the number of bytes pulled from the source
+   *
+   * @return std::uint64_t - number of bytes pulled since construction
+   */
+  [[nodiscard]] std::uint64_t bytes_read() const
+  {
+    return m_bytes_read;
+  }
+
+private:
+  std::array<hal::byte, chunk_size> m_chunk{};
+  std::size_t m_position = 0;
+  std::size_t m_size = 0;
+  std::uint64_t m_bytes_read = 0;
+};
+}  // namespace hal::display
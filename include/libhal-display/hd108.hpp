@@ -0,0 +1,277 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include <libhal-util/inert_drivers/inert_output_pin.hpp>
+#include <libhal-util/output_pin.hpp>
+#include <libhal-util/spi.hpp>
+
+#include "color.hpp"
+
+namespace hal::display {
+
+/**
+ * @brief A single hd108 pixel as sent over SPI
+ *
+ * Each pixel starts with a 16-bit header holding a start bit and a 5-bit
+ * gain for each of red, green and blue, followed by a 16-bit value for each
+ * channel. Every field is sent most significant byte first.
+ */
+struct hd108_pixel
+{
+  /// Start bit, the red gain and the upper 2 bits of the green gain
+  hal::byte header_high = 0xFF;
+  /// Lower 3 bits of the green gain and the blue gain
+  hal::byte header_low = 0xFF;
+  hal::byte red_high = 0;
+  hal::byte red_low = 0;
+  hal::byte green_high = 0;
+  hal::byte green_low = 0;
+  hal::byte blue_high = 0;
+  hal::byte blue_low = 0;
+};
+
+static_assert(8U == sizeof(hd108_pixel),
+              "HD108 Pixel structure must be 8 bytes in length");
+
+/**
+ * @brief Contains the pixels to send to an hd108 strip over SPI
+ *
+ * @tparam pixel_count - Number of pixels to control
+ */
+template<std::size_t pixel_count>
+struct hd108_frame
+{
+  std::array<hd108_pixel, pixel_count> pixels;
+};
+
+/**
+ * @brief Calculates the number of bytes needed to store the pixel data for an
+ * hd108 strip
+ *
+ * Use this to size a caller provided buffer for `hd108_frame_view`.
+ *
+ * @param p_pixel_count - Number of pixels to control
+ * @return constexpr std::size_t - number of bytes needed for the pixel data
+ */
+constexpr std::size_t hd108_frame_size(std::size_t p_pixel_count)
+{
+  return p_pixel_count * sizeof(hd108_pixel);
+}
+
+/**
+ * @brief Runtime sized view of hd108 pixels stored in a caller provided buffer
+ *
+ * The view does not own the pixels, thus the buffer must outlive the view.
+ */
+class hd108_frame_view
+{
+public:
+  /// Color type accepted by `set()`
+  using color_type = rgb161616;
+  /// Value of each 5-bit gain field at full current
+  static constexpr hal::byte max_gain = 0b1'1111;
+
+  /**
+   * @brief Construct a view over every pixel in the buffer
+   *
+   * @param p_pixels - buffer holding the pixels to control
+   */
+  constexpr hd108_frame_view(std::span<hd108_pixel> p_pixels)
+    : m_pixels(p_pixels)
+  {
+  }
+
+  /**
+   * @brief Construct a view over the pixels of a compile time sized frame
+   *
+   * @tparam pixel_count - Number of pixels to control is set implicitly
+   * @param p_frame - frame to view
+   */
+  template<std::size_t pixel_count>
+  constexpr hd108_frame_view(hd108_frame<pixel_count>& p_frame)
+    : m_pixels(p_frame.pixels)
+  {
+  }
+
+  /**
+   * @brief Get the pixels within this view
+   *
+   * @return constexpr std::span<hd108_pixel> - the pixels within this view
+   */
+  [[nodiscard]] constexpr std::span<hd108_pixel> pixels() const
+  {
+    return m_pixels;
+  }
+
+  /**
+   * @brief Get the number of pixels within this view
+   *
+   * @return constexpr std::size_t - number of pixels within this view
+   */
+  [[nodiscard]] constexpr std::size_t pixel_count() const
+  {
+    return m_pixels.size();
+  }
+
+  /**
+   * @brief Set the 16-bit color of a pixel, leaving its gain unchanged
+   *
+   * @param p_index - index of the pixel, must be less than `pixel_count()`
+   * @param p_color - color to set the pixel to
+   */
+  constexpr void set(std::size_t p_index, rgb161616 p_color) const
+  {
+    auto& pixel = m_pixels[p_index];
+    pixel.red_high = static_cast<hal::byte>(p_color.red >> 8U);
+    pixel.red_low = static_cast<hal::byte>(p_color.red);
+    pixel.green_high = static_cast<hal::byte>(p_color.green >> 8U);
+    pixel.green_low = static_cast<hal::byte>(p_color.green);
+    pixel.blue_high = static_cast<hal::byte>(p_color.blue >> 8U);
+    pixel.blue_low = static_cast<hal::byte>(p_color.blue);
+  }
+
+  /**
+   * @brief Set the color of a pixel from an 8-bit color, leaving its gain
+   * unchanged
+   *
+   * Each channel is widened so 0 maps to 0 and 255 maps to 65535.
+   *
+   * @param p_index - index of the pixel, must be less than `pixel_count()`
+   * @param p_color - color to set the pixel to
+   */
+  constexpr void set(std::size_t p_index, rgb888 p_color) const
+  {
+    set(p_index,
+        rgb161616{
+          .red = static_cast<std::uint16_t>(p_color.red * 257U),
+          .green = static_cast<std::uint16_t>(p_color.green * 257U),
+          .blue = static_cast<std::uint16_t>(p_color.blue * 257U),
+        });
+  }
+
+  /**
+   * @brief Get the 16-bit color of a pixel, ignoring its gain
+   *
+   * @param p_index - index of the pixel, must be less than `pixel_count()`
+   * @return constexpr rgb161616 - the color of the pixel
+   */
+  [[nodiscard]] constexpr rgb161616 get(std::size_t p_index) const
+  {
+    auto const& pixel = m_pixels[p_index];
+    return {
+      .red = static_cast<std::uint16_t>((pixel.red_high << 8U) | pixel.red_low),
+      .green =
+        static_cast<std::uint16_t>((pixel.green_high << 8U) | pixel.green_low),
+      .blue =
+        static_cast<std::uint16_t>((pixel.blue_high << 8U) | pixel.blue_low),
+    };
+  }
+
+  /**
+   * @brief Set the 5-bit current gain of each channel of a pixel
+   *
+   * @param p_index - index of the pixel, must be less than `pixel_count()`
+   * @param p_red - gain of the red LED, 0 to `max_gain`
+   * @param p_green - gain of the green LED, 0 to `max_gain`
+   * @param p_blue - gain of the blue LED, 0 to `max_gain`
+   */
+  constexpr void set_gain(std::size_t p_index,
+                          hal::byte p_red,
+                          hal::byte p_green,
+                          hal::byte p_blue) const
+  {
+    std::uint16_t const header = 0x8000U | ((p_red & max_gain) << 10U) |
+                                 ((p_green & max_gain) << 5U) |
+                                 (p_blue & max_gain);
+    auto& pixel = m_pixels[p_index];
+    pixel.header_high = static_cast<hal::byte>(header >> 8U);
+    pixel.header_low = static_cast<hal::byte>(header);
+  }
+
+  /**
+   * @brief Set every pixel to the same color, leaving gain unchanged
+   *
+   * @param p_color - color to set every pixel to
+   */
+  constexpr void fill(rgb161616 p_color) const
+  {
+    for (std::size_t i = 0; i < pixel_count(); i++) {
+      set(i, p_color);
+    }
+  }
+
+  /**
+   * @brief Turn every pixel off, leaving gain unchanged
+   *
+   */
+  constexpr void clear() const
+  {
+    fill(rgb161616{});
+  }
+
+private:
+  std::span<hd108_pixel> m_pixels;
+};
+
+/**
+ * @brief Driver for hd108 RGB LEDs with 16 bits per channel
+ *
+ * The hd108 shares the clock and data wiring of the apa102 but sends 8 bytes
+ * per pixel: a header with a separate current gain for each channel, then a
+ * 16-bit value for each channel.
+ */
+class hd108
+{
+public:
+  /**
+   * @brief Construct a new hd108 object
+   *
+   * @param p_spi the spi bus that controls the LEDs
+   * @param p_chip_select output pin acting as the chip select for the spi bus
+   */
+  hd108(hal::spi& p_spi,
+        hal::output_pin& p_chip_select = hal::default_inert_output_pin());
+
+  /**
+   * @brief Update the state of the LEDs
+   *
+   * @tparam pixel_count - Number of pixels to control is set implicitly, user
+   * should not set it manually
+   * @param p_frame frame to send to control LEDs
+   */
+  template<std::size_t pixel_count>
+  void update(hd108_frame<pixel_count>& p_frame)
+  {
+    update(hd108_frame_view(p_frame));
+  }
+
+  /**
+   * @brief Update the state of the LEDs from a runtime sized frame
+   *
+   * @param p_frame - view of the pixels to send to control LEDs
+   */
+  void update(hd108_frame_view p_frame);
+
+private:
+  hal::spi* m_spi;
+  hal::output_pin* m_chip_select;
+};
+}  // namespace hal::display
@@ -0,0 +1,124 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include <libhal/units.hpp>
+
+#include "color.hpp"
+
+namespace hal::display {
+
+/**
+ * @brief The individual LEDs that make up a pixel
+ *
+ */
+enum class color_channel : std::uint8_t
+{
+  red,
+  green,
+  blue,
+  white,
+};
+
+/**
+ * @brief Describes the order the color channels of a pixel are sent in
+ *
+ * Everything about the format is known at compile time, so drivers templated
+ * on a format compute their sizes and channel order without branching at
+ * runtime.
+ *
+ * @tparam Channels - color channels in the order they are sent to the LED
+ */
+template<color_channel... Channels>
+struct pixel_format
+{
+  /// The amount of LEDs internal to each pixel
+  static constexpr std::size_t channel_count = sizeof...(Channels);
+  /// The color channels in the order they are sent to the LED
+  static constexpr std::array<color_channel, channel_count> channels{
+    Channels...
+  };
+  /// Whether pixels of this format have a dedicated white LED
+  static constexpr bool has_white = ((Channels == color_channel::white) || ...);
+  /// Color type holding one value per channel of this format
+  using color_type = std::conditional_t<has_white, rgbw8888, rgb888>;
+};
+
+/// WS2812B, WS2813, SK6812 (RGB) and most other one wire RGB LEDs
+using grb_format =
+  pixel_format<color_channel::green, color_channel::red, color_channel::blue>;
+/// WS2811 and other one wire LEDs wired in RGB order
+using rgb_format =
+  pixel_format<color_channel::red, color_channel::green, color_channel::blue>;
+/// SK6812 RGBW
+using grbw_format = pixel_format<color_channel::green,
+                                 color_channel::red,
+                                 color_channel::blue,
+                                 color_channel::white>;
+/// SK6812 RGBW variants wired in RGBW order
+using rgbw_format = pixel_format<color_channel::red,
+                                 color_channel::green,
+                                 color_channel::blue,
+                                 color_channel::white>;
+
+/**
+ * @brief Get the value of a single channel of a color
+ *
+ * @tparam Channel - channel to get, white requires an rgbw8888 color
+ * @tparam Color - rgb888 or rgbw8888
+ * @param p_color - color to read from
+ * @return constexpr hal::byte - value of the channel
+ */
+template<color_channel Channel, typename Color>
+constexpr hal::byte get_channel(Color const& p_color)
+{
+  if constexpr (Channel == color_channel::red) {
+    return p_color.red;
+  } else if constexpr (Channel == color_channel::green) {
+    return p_color.green;
+  } else if constexpr (Channel == color_channel::blue) {
+    return p_color.blue;
+  } else {
+    return p_color.white;
+  }
+}
+
+/**
+ * @brief Set the value of a single channel of a color
+ *
+ * @tparam Channel - channel to set, white requires an rgbw8888 color
+ * @tparam Color - rgb888 or rgbw8888
+ * @param p_color - color to modify
+ * @param p_value - new value of the channel
+ */
+template<color_channel Channel, typename Color>
+constexpr void set_channel(Color& p_color, hal::byte p_value)
+{
+  if constexpr (Channel == color_channel::red) {
+    p_color.red = p_value;
+  } else if constexpr (Channel == color_channel::green) {
+    p_color.green = p_value;
+  } else if constexpr (Channel == color_channel::blue) {
+    p_color.blue = p_value;
+  } else {
+    p_color.white = p_value;
+  }
+}
+}  // namespace hal::display
@@ -0,0 +1,371 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+
+#include <libhal/units.hpp>
+
+#include "color.hpp"
+
+namespace hal::display {
+
+/**
+ * @brief Scale every value of a plane by the same factor
+ *
+ * @param p_plane - plane to scale in place
+ * @param p_factor - scale factor where 255 represents 1.0
+ */
+constexpr void scale_plane(std::span<hal::byte> p_plane, hal::byte p_factor)
+{
+  for (auto& value : p_plane) {
+    value = scale_channel(value, p_factor);
+  }
+}
+
+/**
+ * @brief Add the same amount to every value of a plane, saturating at 255
+ *
+ * @param p_plane - plane to brighten in place
+ * @param p_amount - amount to add to each value
+ */
+constexpr void add_plane(std::span<hal::byte> p_plane, hal::byte p_amount)
+{
+  for (auto& value : p_plane) {
+    value = static_cast<hal::byte>(std::min(value + p_amount, 255));
+  }
+}
+
+/**
+ * @brief Subtract the same amount from every value of a plane, saturating at 0
+ *
+ * @param p_plane - plane to darken in place
+ * @param p_amount - amount to subtract from each value
+ */
+constexpr void subtract_plane(std::span<hal::byte> p_plane, hal::byte p_amount)
+{
+  for (auto& value : p_plane) {
+    value = static_cast<hal::byte>(std::max(value - p_amount, 0));
+  }
+}
+
+/**
+ * @brief Mix every value of a plane towards the matching value of another
+ *
+ * Mixes as many values as both planes hold.
+ *
+ * @param p_plane - plane to mix in place
+ * @param p_target - values to move towards
+ * @param p_amount - how far to move towards `p_target`, where 255 represents
+ * 1.0
+ */
+constexpr void mix_plane(std::span<hal::byte> p_plane,
+                         std::span<hal::byte const> p_target,
+                         hal::byte p_amount)
+{
+  auto const count = std::min(p_plane.size(), p_target.size());
+  for (std::size_t i = 0; i < count; i++) {
+    p_plane[i] = mix_channel(p_plane[i], p_target[i], p_amount);
+  }
+}
+
+/**
+ * @brief Stands in for a plane that a `planar_frame` does not store
+ *
+ * Takes up no space and converts to an empty plane.
+ *
+ * @tparam Id - distinguishes the placeholders of different planes, as two
+ * members of the same empty type cannot share an address and would take up
+ * space
+ */
+template<std::size_t Id>
+struct no_plane
+{
+  constexpr operator std::span<hal::byte>() const
+  {
+    return {};
+  }
+};
+
+/// A plane of `PixelCount` values if `Stored` is true, otherwise a `no_plane`
+template<std::size_t PixelCount, bool Stored, std::size_t Id>
+using optional_plane =
+  std::conditional_t<Stored, std::array<hal::byte, PixelCount>, no_plane<Id>>;
+
+/**
+ * @brief Create an `optional_plane` with every stored value set to one value
+ *
+ * @tparam PixelCount - Number of pixels in the plane
+ * @tparam Stored - Whether the plane is stored
+ * @tparam Id - distinguishes the placeholders of different planes
+ * @param p_value - value of every pixel of the plane
+ * @return constexpr optional_plane<PixelCount, Stored, Id> - the filled plane
+ */
+template<std::size_t PixelCount, bool Stored, std::size_t Id>
+constexpr optional_plane<PixelCount, Stored, Id> filled_plane(hal::byte p_value)
+{
+  optional_plane<PixelCount, Stored, Id> plane{};
+  if constexpr (Stored) {
+    plane.fill(p_value);
+  }
+  return plane;
+}
+
+/**
+ * @brief Working buffer that stores each channel of a strip in its own array
+ *
+ * Effects that work on one channel at a time, such as fading only red, walk a
+ * contiguous array instead of striding over interleaved or encoded pixels,
+ * which lets compilers vectorize them. Drivers interleave, and for ws2812b
+ * encode, the planes in a single pass as the data is sent.
+ *
+ * @tparam PixelCount - Number of pixels to control
+ * @tparam HasWhite - Whether to store a plane for a dedicated white LED
+ * @tparam HasBrightness - Whether to store a plane for the 5-bit apa102 global
+ * brightness of each pixel
+ */
+template<std::size_t PixelCount,
+         bool HasWhite = false,
+         bool HasBrightness = false>
+struct planar_frame
+{
+  std::array<hal::byte, PixelCount> red{};
+  std::array<hal::byte, PixelCount> green{};
+  std::array<hal::byte, PixelCount> blue{};
+  [[no_unique_address]] optional_plane<PixelCount, HasWhite, 0> white{};
+  /// Starts at full brightness, like `apa102_pixel`, so filling the color
+  /// planes is enough to light the strip
+  [[no_unique_address]] optional_plane<PixelCount, HasBrightness, 1>
+    brightness = filled_plane<PixelCount, HasBrightness, 1>(0b1'1111);
+};
+
+/**
+ * @brief Calculates the number of bytes needed to store the planes of a
+ * planar working buffer
+ *
+ * Use this to size caller provided planes for `planar_frame_view`, or to plan
+ * the RAM taken by a `planar_frame`.
+ *
+ * @param p_pixel_count - Number of pixels to control
+ * @param p_has_white - Whether a white plane is stored
+ * @param p_has_brightness - Whether a brightness plane is stored
+ * @return constexpr std::size_t - number of bytes needed for every plane
+ */
+constexpr std::size_t planar_frame_size(std::size_t p_pixel_count,
+                                        bool p_has_white = false,
+                                        bool p_has_brightness = false)
+{
+  std::size_t const planes = 3U + (p_has_white ? 1U : 0U) +
+                             (p_has_brightness ? 1U : 0U);
+  return p_pixel_count * planes;
+}
+
+/**
+ * @brief Runtime sized view of the planes of a planar working buffer
+ *
+ * The view does not own the planes, thus they must outlive the view.
+ */
+class planar_frame_view
+{
+public:
+  /// Color type accepted by `set()`
+  using color_type = rgb888;
+
+  /**
+   * @brief Construct a view over caller provided planes
+   *
+   * @param p_red - red plane, its size sets the number of pixels
+   * @param p_green - green plane, at least as large as `p_red`
+   * @param p_blue - blue plane, at least as large as `p_red`
+   * @param p_white - white plane, either empty or at least as large as `p_red`
+   * @param p_brightness - 5-bit global brightness plane, either empty or at
+   * least as large as `p_red`. A brightness of 0 turns the pixel off, so
+   * caller provided planes must be set before the color is visible.
+   * @throws hal::argument_out_of_domain - if a plane is too small
+   */
+  planar_frame_view(std::span<hal::byte> p_red,
+                    std::span<hal::byte> p_green,
+                    std::span<hal::byte> p_blue,
+                    std::span<hal::byte> p_white = {},
+                    std::span<hal::byte> p_brightness = {});
+
+  /**
+   * @brief Construct a view over the planes of a compile time sized frame
+   *
+   * @tparam PixelCount - Number of pixels to control is set implicitly
+   * @tparam HasWhite - Whether the frame stores a white plane
+   * @tparam HasBrightness - Whether the frame stores a brightness plane
+   * @param p_frame - frame to view
+   */
+  template<std::size_t PixelCount, bool HasWhite, bool HasBrightness>
+  constexpr planar_frame_view(
+    planar_frame<PixelCount, HasWhite, HasBrightness>& p_frame)
+    : m_red(p_frame.red)
+    , m_green(p_frame.green)
+    , m_blue(p_frame.blue)
+    , m_white(p_frame.white)
+    , m_brightness(p_frame.brightness)
+  {
+  }
+
+  /**
+   * @brief Get the number of pixels within this view
+   *
+   * @return constexpr std::size_t - number of pixels within this view
+   */
+  [[nodiscard]] constexpr std::size_t pixel_count() const
+  {
+    return m_red.size();
+  }
+
+  /// @return constexpr std::span<hal::byte> - the red value of each pixel
+  [[nodiscard]] constexpr std::span<hal::byte> red() const
+  {
+    return m_red;
+  }
+
+  /// @return constexpr std::span<hal::byte> - the green value of each pixel
+  [[nodiscard]] constexpr std::span<hal::byte> green() const
+  {
+    return m_green;
+  }
+
+  /// @return constexpr std::span<hal::byte> - the blue value of each pixel
+  [[nodiscard]] constexpr std::span<hal::byte> blue() const
+  {
+    return m_blue;
+  }
+
+  /// @return constexpr std::span<hal::byte> - the white value of each pixel,
+  /// empty if there is no white plane
+  [[nodiscard]] constexpr std::span<hal::byte> white() const
+  {
+    return m_white;
+  }
+
+  /// @return constexpr std::span<hal::byte> - the 5-bit global brightness of
+  /// each pixel, empty if there is no brightness plane
+  [[nodiscard]] constexpr std::span<hal::byte> brightness() const
+  {
+    return m_brightness;
+  }
+
+  /**
+   * @brief Set the color of a pixel
+   *
+   * The white value, if there is a white plane, is left unchanged.
+   *
+   * @param p_index - index of the pixel, must be less than `pixel_count()`
+   * @param p_color - color to set the pixel to
+   */
+  constexpr void set(std::size_t p_index, rgb888 p_color) const
+  {
+    m_red[p_index] = p_color.red;
+    m_green[p_index] = p_color.green;
+    m_blue[p_index] = p_color.blue;
+  }
+
+  /**
+   * @brief Set the color of a pixel with a white LED
+   *
+   * The white value is discarded if there is no white plane.
+   *
+   * @param p_index - index of the pixel, must be less than `pixel_count()`
+   * @param p_color - color to set the pixel to
+   */
+  constexpr void set_rgbw(std::size_t p_index, rgbw8888 p_color) const
+  {
+    set(p_index, rgb888{ p_color.red, p_color.green, p_color.blue });
+    if (!m_white.empty()) {
+      m_white[p_index] = p_color.white;
+    }
+  }
+
+  /**
+   * @brief Get the color of a pixel
+   *
+   * @param p_index - index of the pixel, must be less than `pixel_count()`
+   * @return constexpr rgb888 - the color of the pixel
+   */
+  [[nodiscard]] constexpr rgb888 get(std::size_t p_index) const
+  {
+    return { m_red[p_index], m_green[p_index], m_blue[p_index] };
+  }
+
+  /**
+   * @brief Get the color of a pixel including its white value
+   *
+   * @param p_index - index of the pixel, must be less than `pixel_count()`
+   * @return constexpr rgbw8888 - the color of the pixel, with a white value of
+   * 0 if there is no white plane
+   */
+  [[nodiscard]] constexpr rgbw8888 get_rgbw(std::size_t p_index) const
+  {
+    return {
+      m_red[p_index],
+      m_green[p_index],
+      m_blue[p_index],
+      m_white.empty() ? hal::byte{ 0 } : m_white[p_index],
+    };
+  }
+
+  /**
+   * @brief Set every pixel to the same color
+   *
+   * @param p_color - color to set every pixel to
+   */
+  constexpr void fill(rgb888 p_color) const
+  {
+    std::ranges::fill(m_red, p_color.red);
+    std::ranges::fill(m_green, p_color.green);
+    std::ranges::fill(m_blue, p_color.blue);
+  }
+
+  /**
+   * @brief Turn every pixel off, including the white plane
+   *
+   */
+  constexpr void clear() const
+  {
+    fill(rgb888{});
+    std::ranges::fill(m_white, 0);
+  }
+
+  /**
+   * @brief Scale every color plane, including white, by the same factor
+   *
+   * @param p_factor - scale factor where 255 represents 1.0
+   */
+  constexpr void scale(hal::byte p_factor) const
+  {
+    scale_plane(m_red, p_factor);
+    scale_plane(m_green, p_factor);
+    scale_plane(m_blue, p_factor);
+    scale_plane(m_white, p_factor);
+  }
+
+private:
+  std::span<hal::byte> m_red;
+  std::span<hal::byte> m_green;
+  std::span<hal::byte> m_blue;
+  std::span<hal::byte> m_white;
+  std::span<hal::byte> m_brightness;
+};
+}  // namespace hal::display
@@ -0,0 +1,145 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <libhal/units.hpp>
+
+#include "color.hpp"
+
+namespace hal::display {
+
+/**
+ * @brief Electrical characteristics of an LED strip and its power supply
+ *
+ */
+struct power_model
+{
+  /// Current drawn by a single color channel of one LED at full intensity
+  std::uint32_t milliamps_per_channel = 20;
+  /// Current drawn by the driver IC of one LED with all channels off
+  std::uint32_t idle_milliamps_per_pixel = 1;
+  /// Maximum current the power supply can deliver to the strip, 0 means the
+  /// supply has no limit and frames are never scaled
+  std::uint32_t budget_milliamps = 0;
+};
+
+/**
+ * @brief Tracks the estimated current draw of a frame as its pixels are
+ * written
+ *
+ * Frame views constructed with a meter report each pixel change to it, so the
+ * total is always up to date without a separate pass over the frame. Driver
+ * `update()` overloads given such a view, or given a meter directly, use
+ * `scale()` to dim the whole frame by a single factor, applied while the data
+ * is sent, when the frame would exceed the budget. Usage:
+ *
+ *     hal::display::power_meter meter({ .budget_milliamps = 2000 });
+ *     hal::display::ws2812b_spi_frame_view view(frame, meter);
+ *     view.clear();
+ *     view.fill(white);
+ *     driver.update(view);
+ */
+class power_meter
+{
+public:
+  /// Value of the 5-bit apa102 global brightness field at full brightness.
+  /// LEDs without a brightness field are treated as always at full brightness.
+  static constexpr hal::byte max_brightness = 31;
+  /// Load of a single channel at full intensity and full brightness
+  static constexpr std::uint32_t full_channel_load = 255U * max_brightness;
+
+  /**
+   * @brief Calculate the load of a pixel
+   *
+   * The load is the sum of the channel values weighted by the global
+   * brightness of the pixel.
+   *
+   * @param p_color - color of the pixel
+   * @param p_brightness - 5-bit global brightness of the pixel
+   * @return constexpr std::uint32_t - load of the pixel
+   */
+  static constexpr std::uint32_t load(rgb888 p_color,
+                                      hal::byte p_brightness = max_brightness)
+  {
+    return (p_color.red + p_color.green + p_color.blue) * p_brightness;
+  }
+
+  /**
+   * @brief Calculate the load of a pixel with a white LED
+   *
+   * @param p_color - color of the pixel
+   * @param p_brightness - 5-bit global brightness of the pixel
+   * @return constexpr std::uint32_t - load of the pixel
+   */
+  static constexpr std::uint32_t load(rgbw8888 p_color,
+                                      hal::byte p_brightness = max_brightness)
+  {
+    return (p_color.red + p_color.green + p_color.blue + p_color.white) *
+           p_brightness;
+  }
+
+  /**
+   * @brief Construct a new power meter for a frame with every pixel off
+   *
+   * @param p_model - electrical characteristics of the strip and supply
+   */
+  power_meter(power_model p_model);
+
+  /**
+   * @brief Record that a pixel changed
+   *
+   * @param p_previous_load - load of the pixel before it was written
+   * @param p_next_load - load of the pixel after it was written
+   */
+  void exchange(std::uint32_t p_previous_load, std::uint32_t p_next_load)
+  {
+    m_load = m_load - p_previous_load + p_next_load;
+  }
+
+  /**
+   * @brief Forget all recorded loads, for use after every pixel is turned off
+   *
+   */
+  void reset()
+  {
+    m_load = 0;
+  }
+
+  /**
+   * @brief Estimate the current drawn by the frame before any scaling
+   *
+   * @param p_pixel_count - number of pixels in the frame
+   * @return std::uint32_t - estimated current in milliamps
+   */
+  [[nodiscard]] std::uint32_t milliamps(std::size_t p_pixel_count) const;
+
+  /**
+   * @brief Calculate the factor to scale every channel by to stay within the
+   * budget
+   *
+   * @param p_pixel_count - number of pixels in the frame
+   * @return hal::byte - scale factor where 255 means the frame is within the
+   * budget and should be sent as is
+   */
+  [[nodiscard]] hal::byte scale(std::size_t p_pixel_count) const;
+
+private:
+  power_model m_model;
+  std::uint32_t m_load = 0;
+};
+}  // namespace hal::display
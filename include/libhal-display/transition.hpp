@@ -0,0 +1,374 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include <libhal/units.hpp>
+
+#include "color.hpp"
+
+namespace hal::display {
+
+/**
+ * @brief How the progress of a transition speeds up and slows down over time
+ *
+ */
+enum class easing : hal::byte
+{
+  /// Constant speed
+  linear,
+  /// Start slowly and speed up
+  ease_in,
+  /// Start quickly and slow down
+  ease_out,
+  /// Start slowly, speed up, then slow down again
+  ease_in_out,
+};
+
+/**
+ * @brief How the pixels change from one frame to the other
+ *
+ */
+enum class transition_kind : hal::byte
+{
+  /// Every pixel fades from its old color to its new color
+  crossfade,
+  /// The new frame sweeps over the old one from pixel 0 to the last pixel
+  wipe,
+  /// Pixels switch from the old frame to the new one in a scattered order
+  dissolve,
+};
+
+/**
+ * @brief Apply an easing curve to the progress of a transition
+ *
+ * Uses quadratic curves in integer arithmetic. Every curve maps 0 to 0 and 255
+ * to 255 and never decreases.
+ *
+ * @param p_curve - easing curve to apply
+ * @param p_progress - time elapsed as a fraction of the duration, where 255
+ * represents 1.0
+ * @return constexpr hal::byte - eased progress, where 255 represents 1.0
+ */
+constexpr hal::byte ease(easing p_curve, hal::byte p_progress)
+{
+  std::uint32_t const t = p_progress;
+  std::uint32_t const remaining = 255U - t;
+
+  switch (p_curve) {
+    case easing::ease_in:
+      return scale_channel(p_progress, p_progress);
+    case easing::ease_out:
+      return static_cast<hal::byte>(
+        255U - scale_channel(static_cast<hal::byte>(remaining),
+                             static_cast<hal::byte>(remaining)));
+    case easing::ease_in_out:
+      if (t < 128U) {
+        return static_cast<hal::byte>((2U * t * t + 127U) / 255U);
+      }
+      return static_cast<hal::byte>(
+        255U - ((2U * remaining * remaining + 127U) / 255U));
+    case easing::linear:
+    default:
+      return p_progress;
+  }
+}
+
+/**
+ * @brief Settings of a transition between two frames
+ *
+ */
+struct transition_settings
+{
+  /// How the pixels change from one frame to the other
+  transition_kind kind = transition_kind::crossfade;
+  /// How the progress speeds up and slows down over time
+  easing curve = easing::linear;
+  /// Time the transition takes from start to finish
+  std::chrono::nanoseconds duration = std::chrono::milliseconds(500);
+  /// Varies the order pixels switch in for `transition_kind::dissolve`
+  std::uint32_t seed = 0;
+};
+
+/**
+ * @brief Renders transitions between two frames directly into the frame that
+ * is sent
+ *
+ * Each call to `render()` reads every pixel of both source frames, decoding
+ * ws2812b data as needed, and writes the combined pixel to the output frame.
+ * The cost per pixel is fixed and no intermediate color buffers are needed.
+ * The output may be the old frame itself, so a transition needs no more
+ * memory than the two scenes. Usage:
+ *
+ *     hal::display::transition fade({ .curve = hal::display::easing::ease_out,
+ *                                     .duration = 1s });
+ *     std::chrono::nanoseconds elapsed{};
+ *     while (!fade.render(old_scene, new_scene, old_scene, elapsed)) {
+ *       driver.update(old_scene);
+ *       hal::delay(clock, 10ms);
+ *       elapsed += 10ms;
+ *     }
+ *     driver.update(old_scene);
+ */
+class transition
+{
+public:
+  /**
+   * @brief Construct a new transition
+   *
+   * @param p_settings - settings of the transition
+   */
+  constexpr transition(transition_settings p_settings)
+    : m_settings(p_settings)
+  {
+  }
+
+  /**
+   * @brief Calculate the eased progress of the transition
+   *
+   * @param p_elapsed - time since the transition started
+   * @return constexpr hal::byte - eased progress where 0 shows only the old
+   * frame and 255 shows only the new frame
+   */
+  [[nodiscard]] constexpr hal::byte progress(
+    std::chrono::nanoseconds p_elapsed) const
+  {
+    if (p_elapsed.count() <= 0) {
+      return ease(m_settings.curve, 0);
+    }
+    if (p_elapsed >= m_settings.duration) {
+      return ease(m_settings.curve, 255);
+    }
+    // Work in microseconds so the product cannot overflow for durations of up
+    // to several days
+    using std::chrono::duration_cast;
+    using std::chrono::microseconds;
+    auto const elapsed = duration_cast<microseconds>(p_elapsed).count();
+    auto const duration = std::max<std::int64_t>(
+      1, duration_cast<microseconds>(m_settings.duration).count());
+    auto const linear = (static_cast<std::uint64_t>(elapsed) * 255U) /
+                        static_cast<std::uint64_t>(duration);
+    return ease(m_settings.curve, static_cast<hal::byte>(linear));
+  }
+
+  /**
+   * @brief Write one step of the transition into the output frame
+   *
+   * Renders as many pixels as all three frames hold. The output frame may be
+   * `p_from`, in which case the old frame is moved towards the new frame in
+   * place, see `render(Frame, To, std::chrono::nanoseconds)`. The output must
+   * not be `p_to`.
+   *
+   * @tparam From - frame view type of the old frame
+   * @tparam To - frame view type of the new frame
+   * @tparam Output - frame view type to write the result into
+   * @param p_from - the frame being transitioned away from
+   * @param p_to - the frame being transitioned to
+   * @param p_output - frame to write the result into
+   * @param p_elapsed - time since the transition started
+   * @return true - the transition has finished and `p_output` shows `p_to`
+   * @return false - the transition is still in progress
+   */
+  template<typename From, typename To, typename Output>
+  bool render(From p_from,
+              To p_to,
+              Output p_output,
+              std::chrono::nanoseconds p_elapsed)
+  {
+    if constexpr (std::is_same_v<From, Output>) {
+      if (pixel_address(p_from) == pixel_address(p_output) &&
+          p_from.pixel_count() == p_output.pixel_count()) {
+        return render(p_output, p_to, p_elapsed);
+      }
+    }
+
+    auto const amount = progress(p_elapsed);
+    auto const count = std::min(
+      { p_from.pixel_count(), p_to.pixel_count(), p_output.pixel_count() });
+
+    switch (m_settings.kind) {
+      case transition_kind::wipe: {
+        auto const edge = (count * amount) / 255U;
+        for (std::size_t i = 0; i < count; i++) {
+          p_output.set(i, i < edge ? p_to.get(i) : p_from.get(i));
+        }
+        break;
+      }
+      case transition_kind::dissolve:
+        for (std::size_t i = 0; i < count; i++) {
+          p_output.set(i, switched(i, amount) ? p_to.get(i) : p_from.get(i));
+        }
+        break;
+      case transition_kind::crossfade:
+      default:
+        for (std::size_t i = 0; i < count; i++) {
+          p_output.set(i, mix(p_from.get(i), p_to.get(i), amount));
+        }
+        break;
+    }
+
+    return p_elapsed >= m_settings.duration;
+  }
+
+  /**
+   * @brief Move the old frame one step towards the new frame in place
+   *
+   * Wipe and dissolve only write the pixels that switch to the new frame
+   * since the previous call. Crossfade moves each channel the fraction of the
+   * remaining distance covered since the previous call, so the frame shows
+   * `p_to` exactly once the transition finishes.
+   *
+   * The progress reached is kept between calls. A call with less elapsed time
+   * than the previous call starts a new transition, as does `restart()`.
+   *
+   * @tparam Frame - frame view type of the old frame
+   * @tparam To - frame view type of the new frame
+   * @param p_frame - the frame being transitioned away from, which is
+   * overwritten with each step
+   * @param p_to - the frame being transitioned to
+   * @param p_elapsed - time since the transition started
+   * @return true - the transition has finished and `p_frame` shows `p_to`
+   * @return false - the transition is still in progress
+   */
+  template<typename Frame, typename To>
+  bool render(Frame p_frame, To p_to, std::chrono::nanoseconds p_elapsed)
+  {
+    if (p_elapsed < m_elapsed) {
+      restart();
+    }
+    m_elapsed = p_elapsed;
+
+    auto const previous = m_applied;
+    auto const amount = std::max(progress(p_elapsed), previous);
+    auto const count = std::min(p_frame.pixel_count(), p_to.pixel_count());
+    m_applied = amount;
+
+    switch (m_settings.kind) {
+      case transition_kind::wipe:
+        for (auto i = (count * previous) / 255U; i < (count * amount) / 255U;
+             i++) {
+          p_frame.set(i, p_to.get(i));
+        }
+        break;
+      case transition_kind::dissolve:
+        for (std::size_t i = 0; i < count; i++) {
+          if (switched(i, amount) && !switched(i, previous)) {
+            p_frame.set(i, p_to.get(i));
+          }
+        }
+        break;
+      case transition_kind::crossfade:
+      default:
+        if (amount == previous) {
+          break;
+        }
+        for (std::size_t i = 0; i < count; i++) {
+          p_frame.set(i, step(p_frame.get(i), p_to.get(i), previous, amount));
+        }
+        break;
+    }
+
+    return p_elapsed >= m_settings.duration;
+  }
+
+  /**
+   * @brief Start the next in place `render()` from the beginning
+   *
+   */
+  constexpr void restart()
+  {
+    m_applied = 0;
+    m_elapsed = {};
+  }
+
+  /**
+   * @brief Get the settings of this transition
+   *
+   * @return transition_settings const& - the settings of this transition
+   */
+  [[nodiscard]] constexpr transition_settings const& settings() const
+  {
+    return m_settings;
+  }
+
+private:
+  /// Pseudo random, evenly spread progress at which a pixel switches frames
+  /// when dissolving
+  [[nodiscard]] constexpr hal::byte threshold(std::size_t p_index) const
+  {
+    auto hash = static_cast<std::uint32_t>(p_index) ^ m_settings.seed;
+    hash *= 2654435761U;
+    hash ^= hash >> 15U;
+    hash *= 2246822519U;
+    return static_cast<hal::byte>(hash >> 24U);
+  }
+
+  /// Whether a dissolving pixel shows the new frame at a progress
+  [[nodiscard]] constexpr bool switched(std::size_t p_index,
+                                        hal::byte p_amount) const
+  {
+    return p_amount == 255 || threshold(p_index) < p_amount;
+  }
+
+  /// Move a channel from its value at progress `p_previous` to its value at
+  /// progress `p_amount`, rounded to nearest
+  static constexpr hal::byte step_channel(hal::byte p_current,
+                                          hal::byte p_to,
+                                          hal::byte p_previous,
+                                          hal::byte p_amount)
+  {
+    auto const remaining = 255 - p_previous;
+    auto const moved = (p_to - p_current) * (p_amount - p_previous);
+    auto const rounding = moved < 0 ? -(remaining / 2) : remaining / 2;
+    return static_cast<hal::byte>(p_current + (moved + rounding) / remaining);
+  }
+
+  static constexpr rgb888 step(rgb888 p_current,
+                               rgb888 p_to,
+                               hal::byte p_previous,
+                               hal::byte p_amount)
+  {
+    return {
+      .red = step_channel(p_current.red, p_to.red, p_previous, p_amount),
+      .green = step_channel(p_current.green, p_to.green, p_previous, p_amount),
+      .blue = step_channel(p_current.blue, p_to.blue, p_previous, p_amount),
+    };
+  }
+
+  static constexpr rgbw8888 step(rgbw8888 p_current,
+                                 rgbw8888 p_to,
+                                 hal::byte p_previous,
+                                 hal::byte p_amount)
+  {
+    return {
+      .red = step_channel(p_current.red, p_to.red, p_previous, p_amount),
+      .green = step_channel(p_current.green, p_to.green, p_previous, p_amount),
+      .blue = step_channel(p_current.blue, p_to.blue, p_previous, p_amount),
+      .white = step_channel(p_current.white, p_to.white, p_previous, p_amount),
+    };
+  }
+
+  transition_settings m_settings;
+  /// Progress already applied by the in place `render()`
+  hal::byte m_applied = 0;
+  /// Elapsed time of the last in place `render()`
+  std::chrono::nanoseconds m_elapsed{};
+};
+}  // namespace hal::display
@@ -0,0 +1,146 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace hal::display {
+
+/**
+ * @brief Lock-free handoff of frames from a renderer to a transmitter
+ *
+ * Holds three frames: one the renderer draws into (back), one the transmitter
+ * sends from (front) and the most recently completed frame between them
+ * (middle). Publishing and acquiring each swap a single atomic index, so
+ * neither side ever blocks or waits on the other, and the transmitter always
+ * sends the latest complete frame. Frames the transmitter did not get to in
+ * time are dropped.
+ *
+ * Only one renderer and one transmitter may use the buffer, for example the
+ * main loop and a timer interrupt, or two RTOS tasks.
+ *
+ * A buffer of frames that start as all zero bytes, such as
+ * `ws2812b_spi_frame`, is placed in .bss. Frames with nonzero defaults keep
+ * the buffer in .data, which stores a copy of all three frames in flash. This
+ * includes `apa102_frame`, whose pixels default to full brightness.
+ *
+ * @tparam Frame - frame type, such as `apa102_frame<N>`, `ws2812b_spi_frame<N>`
+ * or a frame view over a caller provided buffer
+ */
+template<typename Frame>
+class triple_buffer
+{
+public:
+  static_assert(std::atomic<std::uint8_t>::is_always_lock_free,
+                "triple_buffer requires lock-free byte sized atomics");
+
+  /**
+   * @brief Construct a triple buffer of default constructed frames
+   *
+   */
+  triple_buffer() = default;
+
+  /**
+   * @brief Construct a triple buffer from three frames
+   *
+   * Use this with frame views so each view refers to its own buffer.
+   *
+   * @param p_first - first frame, initially the back frame
+   * @param p_second - second frame, initially the front frame
+   * @param p_third - third frame, initially the middle frame
+   */
+  triple_buffer(Frame p_first, Frame p_second, Frame p_third)
+    : m_frames{ p_first, p_second, p_third }
+  {
+  }
+
+  /**
+   * @brief Renderer: get the frame to draw into
+   *
+   * The contents are whatever frame was handed back by the last `publish()`,
+   * so renderers that only redraw parts of a frame must redraw it fully.
+   *
+   * @return Frame& - the back frame
+   */
+  Frame& back()
+  {
+    return m_frames[m_back];
+  }
+
+  /**
+   * @brief Renderer: make the back frame the latest complete frame
+   *
+   * Swaps the back frame with the middle frame. Never blocks.
+   */
+  void publish()
+  {
+    auto const previous = m_middle.exchange((m_back ^ middle_key) | fresh,
+                                            std::memory_order_acq_rel);
+    m_back = (previous & index_mask) ^ middle_key;
+  }
+
+  /**
+   * @brief Transmitter: take the latest complete frame, if there is a new one
+   *
+   * Swaps the front frame with the middle frame when the renderer published
+   * since the last call. Never blocks.
+   *
+   * @return true - `front()` now holds a newly published frame
+   * @return false - nothing new was published, `front()` is unchanged
+   */
+  bool acquire()
+  {
+    if ((m_middle.load(std::memory_order_relaxed) & fresh) == 0) {
+      return false;
+    }
+    auto const front = m_front ^ front_key;
+    auto const previous =
+      m_middle.exchange(front ^ middle_key, std::memory_order_acq_rel);
+    m_front = (previous & index_mask) ^ middle_key ^ front_key;
+    return true;
+  }
+
+  /**
+   * @brief Transmitter: get the frame to send
+   *
+   * @return Frame& - the front frame
+   */
+  Frame& front()
+  {
+    return m_frames[m_front ^ front_key];
+  }
+
+private:
+  static constexpr std::uint8_t index_mask = 0b011;
+  static constexpr std::uint8_t fresh = 0b100;
+  // The front and middle indices are stored XORed with a key so the initial
+  // state of back 0, front 1 and middle 2 is all zero bits. A zero
+  // initialized buffer is placed in .bss instead of .data, which would also
+  // store a copy of all three frames in flash.
+  static constexpr std::uint8_t front_key = 1;
+  static constexpr std::uint8_t middle_key = 2;
+
+  std::array<Frame, 3> m_frames{};
+  // Owned by the renderer
+  std::uint8_t m_back = 0;
+  // Owned by the transmitter, XORed with `front_key`
+  std::uint8_t m_front = 0;
+  // Shared, holds the middle index XORed with `middle_key` and whether it was
+  // published but not yet acquired
+  std::atomic<std::uint8_t> m_middle{ 0 };
+};
+}  // namespace hal::display
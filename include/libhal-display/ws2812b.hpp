@@ -14,14 +14,132 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <utility>
 
 #include <libhal-util/inert_drivers/inert_output_pin.hpp>
 #include <libhal-util/output_pin.hpp>
 #include <libhal-util/spi.hpp>
+#include <libhal/error.hpp>
+
+#include "color.hpp"
+#include "pixel_format.hpp"
+#include "planar.hpp"
+#include "power.hpp"
 
 namespace hal::display {
 
+/**
+ * @brief SPI bit patterns for each 4-bit nibble of a ws2812b color channel
+ *
+ * Each data bit is sent as 4 SPI bits, 0b1110 for a 1 and 0b1000 for a 0, so
+ * a nibble becomes 16 SPI bits sent MSB first.
+ */
+inline constexpr std::array<std::uint16_t, 16> ws2812b_nibble_encoding = []() {
+  std::array<std::uint16_t, 16> table{};
+  for (std::size_t nibble = 0; nibble < table.size(); nibble++) {
+    for (std::size_t bit = 0; bit < 4; bit++) {
+      bool const is_set = nibble & (0b1000U >> bit);
+      std::uint16_t const code = is_set ? 0b1110 : 0b1000;
+      table[nibble] |= static_cast<std::uint16_t>(code << (12 - (bit * 4)));
+    }
+  }
+  return table;
+}();
+
+/**
+ * @brief Encodes colors into, and decodes them from, the SPI bit patterns of
+ * ws2812b style one wire LEDs
+ *
+ * @tparam Format - order of the color channels on the wire
+ */
+template<typename Format = grb_format>
+struct ws2812b_encoder
+{
+  /// Color type holding one value per channel of the format
+  using color_type = typename Format::color_type;
+  /// The amount of bytes needed to store the data for one color channel.
+  static constexpr std::size_t bytes_per_channel = 4;
+  /// The amount of bytes needed to store the data for one pixel.
+  static constexpr std::size_t bytes_per_pixel =
+    Format::channel_count * bytes_per_channel;
+  /// Every encoded byte of a channel with a value of 0, as each nibble of 0
+  /// encodes as 0x8888.
+  static constexpr hal::byte off_pattern = 0x88;
+
+  /**
+   * @brief Encode a single 8-bit channel value
+   *
+   * @param p_destination - location of the 4 bytes to write
+   * @param p_value - channel value to encode
+   */
+  static constexpr void encode_channel(hal::byte* p_destination,
+                                       hal::byte p_value)
+  {
+    auto const upper = ws2812b_nibble_encoding[p_value >> 4];
+    auto const lower = ws2812b_nibble_encoding[p_value & 0x0F];
+    p_destination[0] = static_cast<hal::byte>(upper >> 8);
+    p_destination[1] = static_cast<hal::byte>(upper);
+    p_destination[2] = static_cast<hal::byte>(lower >> 8);
+    p_destination[3] = static_cast<hal::byte>(lower);
+  }
+
+  /**
+   * @brief Decode a single 8-bit channel value
+   *
+   * @param p_source - location of the 4 encoded bytes
+   * @return constexpr hal::byte - the channel value
+   */
+  static constexpr hal::byte decode_channel(hal::byte const* p_source)
+  {
+    // Bit 1 of each 4-bit code is only set in the code for a 1 (0b1110)
+    hal::byte value = 0;
+    for (std::size_t i = 0; i < bytes_per_channel; i++) {
+      value = static_cast<hal::byte>(value << 2);
+      value |= static_cast<hal::byte>(((p_source[i] >> 4) & 0b10) |
+                                      ((p_source[i] >> 1) & 0b01));
+    }
+    return value;
+  }
+
+  /**
+   * @brief Encode every channel of a pixel in the order of the format
+   *
+   * @param p_destination - location of the `bytes_per_pixel` bytes to write
+   * @param p_color - color to encode
+   */
+  static constexpr void encode(hal::byte* p_destination, color_type p_color)
+  {
+    [&]<std::size_t... I>(std::index_sequence<I...>) {
+      (encode_channel(p_destination + (I * bytes_per_channel),
+                      get_channel<Format::channels[I]>(p_color)),
+       ...);
+    }(std::make_index_sequence<Format::channel_count>{});
+  }
+
+  /**
+   * @brief Decode every channel of a pixel in the order of the format
+   *
+   * @param p_source - location of the `bytes_per_pixel` encoded bytes
+   * @return constexpr color_type - the color of the pixel
+   */
+  static constexpr color_type decode(hal::byte const* p_source)
+  {
+    color_type color{};
+    [&]<std::size_t... I>(std::index_sequence<I...>) {
+      (set_channel<Format::channels[I]>(
+         color, decode_channel(p_source + (I * bytes_per_channel))),
+       ...);
+    }(std::make_index_sequence<Format::channel_count>{});
+    return color;
+  }
+};
+
 /**
  * @brief Represents the frame of data for the ws2812b pixels to be transmitted
  * over SPI.
@@ -31,12 +149,15 @@ namespace hal::display {
  * data array based on the number of pixels the user specifies.
  *
  * @tparam PixelCount - The number of pixels that are intended to be used.
+ * @tparam Format - The order of the color channels on the wire. Defaults to
+ * the GRB order of the ws2812b, use `grbw_format` for SK6812 RGBW LEDs.
  */
-template<std::size_t PixelCount>
+template<std::size_t PixelCount, typename Format = grb_format>
 struct ws2812b_spi_frame
 {
-  /// The three LEDs internal to each pixel: Red, Green, and Blue.
-  static constexpr std::size_t colors_available = 3;
+  /// The LEDs internal to each pixel: Red, Green, Blue and for some parts
+  /// White.
+  static constexpr std::size_t colors_available = Format::channel_count;
   /// The amount of bits used to represent each internal LEDs value.
   static constexpr std::size_t bits_per_pixel_color = 8;
   /// The amount of bits SPI needs to generate the proper pulses for the data.
@@ -53,9 +174,434 @@ struct ws2812b_spi_frame
   std::array<hal::byte, array_length> data;
 };
 
+/**
+ * @brief Calculates the number of bytes needed to store the SPI encoded data
+ * for a ws2812b strip
+ *
+ * Use this to size a caller provided buffer for `ws2812b_spi_frame_view`.
+ *
+ * @tparam Format - The order of the color channels on the wire.
+ * @param p_pixel_count - The number of pixels that are intended to be used.
+ * @return constexpr std::size_t - number of bytes needed for the encoded data
+ */
+template<typename Format = grb_format>
+constexpr std::size_t ws2812b_spi_frame_size(std::size_t p_pixel_count)
+{
+  return p_pixel_count * ws2812b_encoder<Format>::bytes_per_pixel;
+}
+
+/**
+ * @brief Encode a fixed pattern into a ws2812b frame at compile time
+ *
+ * Meant for patterns known when building, such as boot animations and error
+ * indicators. Declare the result `constexpr` (or `static constexpr` within a
+ * function) so the encoded frame is placed in flash and costs no RAM, then send
+ * it with `ws2812b::update(frame.data)`.
+ *
+ *     static constexpr auto boot = hal::display::make_ws2812b_spi_frame(
+ *       std::array<hal::display::rgb888, 3>{ { { 255, 0, 0 }, {}, {} } });
+ *     driver.update(boot.data);
+ *
+ * @tparam Format - The order of the color channels on the wire.
+ * @tparam PixelCount - The number of pixels, set implicitly from `p_colors`.
+ * @param p_colors - color of each pixel
+ * @return consteval ws2812b_spi_frame<PixelCount, Format> - the encoded frame
+ */
+template<typename Format = grb_format, std::size_t PixelCount>
+consteval ws2812b_spi_frame<PixelCount, Format> make_ws2812b_spi_frame(
+  std::array<typename Format::color_type, PixelCount> const& p_colors)
+{
+  ws2812b_spi_frame<PixelCount, Format> frame{};
+  for (std::size_t i = 0; i < PixelCount; i++) {
+    ws2812b_encoder<Format>::encode(
+      &frame.data[i * ws2812b_encoder<Format>::bytes_per_pixel], p_colors[i]);
+  }
+  return frame;
+}
+
+/**
+ * @brief Runtime sized view of ws2812b SPI encoded data stored in a caller
+ * provided buffer
+ *
+ * Allows the number of pixels to be chosen at runtime, for example from a
+ * configuration value, while the storage comes from a static arena or linker
+ * section sized for the largest supported strip. The view does not own the
+ * data, thus the buffer must outlive the view.
+ *
+ * A view constructed with a `power_meter` reports every pixel it writes to
+ * the meter, including writes made by bulk writers such as the compositor,
+ * transitions and frame receivers, and `ws2812b::update()` keeps the frame
+ * within the budget of that meter. Writes made directly to `data()` are not
+ * tracked.
+ *
+ * @tparam Format - The order of the color channels on the wire.
+ */
+template<typename Format = grb_format>
+class ws2812b_spi_frame_view
+{
+public:
+  /// Encoder for the format of this frame
+  using encoder = ws2812b_encoder<Format>;
+  /// Color type holding one value per channel of the format
+  using color_type = typename Format::color_type;
+  /// The amount of bytes needed to store the data for one pixel.
+  static constexpr std::size_t bytes_per_pixel = encoder::bytes_per_pixel;
+
+  /**
+   * @brief Construct a view over the first `p_pixel_count` pixels of a buffer
+   *
+   * @param p_buffer - buffer of at least
+   * `ws2812b_spi_frame_size<Format>(p_pixel_count)` bytes.
+   * @param p_pixel_count - The number of pixels that are intended to be used.
+   * @throws hal::argument_out_of_domain - if the buffer is too small to hold
+   * `p_pixel_count` pixels
+   */
+  ws2812b_spi_frame_view(std::span<hal::byte> p_buffer,
+                         std::size_t p_pixel_count)
+  {
+    auto const length = ws2812b_spi_frame_size<Format>(p_pixel_count);
+    if (length > p_buffer.size()) {
+      throw hal::argument_out_of_domain(this);
+    }
+    m_data = p_buffer.first(length);
+  }
+
+  /**
+   * @brief Construct a view over the first `p_pixel_count` pixels of a buffer
+   * that reports every write to a power meter
+   *
+   * @param p_buffer - buffer of at least
+   * `ws2812b_spi_frame_size<Format>(p_pixel_count)` bytes.
+   * @param p_pixel_count - The number of pixels that are intended to be used.
+   * @param p_meter - meter tracking the current draw of these pixels, must
+   * match their contents and outlive the view
+   * @throws hal::argument_out_of_domain - if the buffer is too small to hold
+   * `p_pixel_count` pixels
+   */
+  ws2812b_spi_frame_view(std::span<hal::byte> p_buffer,
+                         std::size_t p_pixel_count,
+                         power_meter& p_meter)
+    : ws2812b_spi_frame_view(p_buffer, p_pixel_count)
+  {
+    m_meter = &p_meter;
+  }
+
+  /**
+   * @brief Construct a view over the data of a compile time sized frame
+   *
+   * @tparam PixelCount - The amount of pixels the frame holds.
+   * @param p_frame - frame to view
+   */
+  template<std::size_t PixelCount>
+  constexpr ws2812b_spi_frame_view(
+    ws2812b_spi_frame<PixelCount, Format>& p_frame)
+    : m_data(p_frame.data)
+  {
+  }
+
+  /**
+   * @brief Construct a view over the data of a compile time sized frame that
+   * reports every write to a power meter
+   *
+   * @tparam PixelCount - The amount of pixels the frame holds.
+   * @param p_frame - frame to view
+   * @param p_meter - meter tracking the current draw of `p_frame`, must match
+   * its contents and outlive the view
+   */
+  template<std::size_t PixelCount>
+  constexpr ws2812b_spi_frame_view(
+    ws2812b_spi_frame<PixelCount, Format>& p_frame,
+    power_meter& p_meter)
+    : m_data(p_frame.data)
+    , m_meter(&p_meter)
+  {
+  }
+
+  /**
+   * @brief Get the SPI encoded data within this view
+   *
+   * @return constexpr std::span<hal::byte> - the encoded pixel data
+   */
+  [[nodiscard]] constexpr std::span<hal::byte> data() const
+  {
+    return m_data;
+  }
+
+  /**
+   * @brief Get the number of pixels within this view
+   *
+   * @return constexpr std::size_t - number of pixels within this view
+   */
+  [[nodiscard]] constexpr std::size_t pixel_count() const
+  {
+    return m_data.size() / bytes_per_pixel;
+  }
+
+  /**
+   * @brief Get the power meter this view reports writes to
+   *
+   * @return constexpr power_meter* - the meter, or nullptr if writes are not
+   * tracked
+   */
+  [[nodiscard]] constexpr power_meter* meter() const
+  {
+    return m_meter;
+  }
+
+  /**
+   * @brief Encode a color into the SPI data of a pixel
+   *
+   * @param p_index - index of the pixel, must be less than `pixel_count()`
+   * @param p_color - color to set the pixel to
+   */
+  constexpr void set(std::size_t p_index, color_type p_color) const
+  {
+    if (m_meter != nullptr) {
+      m_meter->exchange(power_meter::load(get(p_index)),
+                        power_meter::load(p_color));
+    }
+    encoder::encode(&m_data[p_index * bytes_per_pixel], p_color);
+  }
+
+  /**
+   * @brief Encode an RGB color into a pixel with a white LED, leaving the white
+   * LED off
+   *
+   * @param p_index - index of the pixel, must be less than `pixel_count()`
+   * @param p_color - color to set the pixel to
+   */
+  constexpr void set(std::size_t p_index, rgb888 p_color) const
+    requires(Format::has_white)
+  {
+    set(p_index, rgbw8888{ p_color.red, p_color.green, p_color.blue, 0 });
+  }
+
+  /**
+   * @brief Set every pixel to the same color
+   *
+   * @param p_color - color to set every pixel to
+   */
+  void fill(color_type p_color) const
+  {
+    fill(0, pixel_count(), p_color);
+  }
+
+  /**
+   * @brief Set a range of pixels to the same color
+   *
+   * The color is encoded once into the first pixel of the range, then the
+   * encoded data is copied in blocks that double in size, so filling N pixels
+   * takes a single encode and log2(N) copies.
+   *
+   * @param p_first - index of the first pixel to set
+   * @param p_count - number of pixels to set, `p_first + p_count` must not
+   * exceed `pixel_count()`
+   * @param p_color - color to set the pixels to
+   */
+  void fill(std::size_t p_first, std::size_t p_count, color_type p_color) const
+  {
+    if (p_count == 0) {
+      return;
+    }
+    if (m_meter != nullptr) {
+      track_fill(p_first, p_count, p_color);
+    }
+    auto const range = m_data.subspan(p_first * bytes_per_pixel,
+                                      p_count * bytes_per_pixel);
+    encoder::encode(range.data(), p_color);
+    std::size_t filled = bytes_per_pixel;
+    while (filled < range.size()) {
+      auto const length = std::min(filled, range.size() - filled);
+      std::memcpy(range.data() + filled, range.data(), length);
+      filled += length;
+    }
+  }
+
+  /**
+   * @brief Turn every pixel off
+   *
+   * A pixel that is off encodes as the same byte throughout, so this is a
+   * single `memset()`.
+   */
+  void clear() const
+  {
+    if (m_meter != nullptr) {
+      m_meter->reset();
+    }
+    std::memset(m_data.data(), encoder::off_pattern, m_data.size());
+  }
+
+  /**
+   * @brief Set a range of pixels to a linear gradient between two colors
+   *
+   * @param p_first - index of the first pixel to set
+   * @param p_count - number of pixels to set, `p_first + p_count` must not
+   * exceed `pixel_count()`
+   * @param p_from - color of the first pixel of the range
+   * @param p_to - color of the last pixel of the range
+   */
+  constexpr void gradient(std::size_t p_first,
+                          std::size_t p_count,
+                          color_type p_from,
+                          color_type p_to) const
+  {
+    for (std::size_t i = 0; i < p_count; i++) {
+      set(p_first + i, mix(p_from, p_to, gradient_amount(i, p_count)));
+    }
+  }
+
+  /**
+   * @brief Decode the color of a pixel from its SPI data
+   *
+   * @param p_index - index of the pixel, must be less than `pixel_count()`
+   * @return constexpr color_type - the color of the pixel
+   */
+  [[nodiscard]] constexpr color_type get(std::size_t p_index) const
+  {
+    return encoder::decode(&m_data[p_index * bytes_per_pixel]);
+  }
+
+private:
+  void track_fill(std::size_t p_first,
+                  std::size_t p_count,
+                  color_type p_color) const
+  {
+    auto const next = power_meter::load(p_color) * p_count;
+    if (p_count == pixel_count()) {
+      m_meter->reset();
+      m_meter->exchange(0, next);
+      return;
+    }
+    std::uint32_t previous = 0;
+    for (std::size_t i = p_first; i < p_first + p_count; i++) {
+      previous += power_meter::load(get(i));
+    }
+    m_meter->exchange(previous, next);
+  }
+
+  std::span<hal::byte> m_data;
+  power_meter* m_meter = nullptr;
+};
+
+template<std::size_t PixelCount, typename Format>
+ws2812b_spi_frame_view(ws2812b_spi_frame<PixelCount, Format>&)
+  -> ws2812b_spi_frame_view<Format>;
+
+template<std::size_t PixelCount, typename Format>
+ws2812b_spi_frame_view(ws2812b_spi_frame<PixelCount, Format>&, power_meter&)
+  -> ws2812b_spi_frame_view<Format>;
+
+/**
+ * @brief Convert HSV colors and encode them directly into a ws2812b frame
+ *
+ * Converts as many pixels as both spans hold.
+ *
+ * @tparam Format - The order of the color channels on the wire.
+ * @param p_colors - colors to convert, one per pixel starting at pixel 0
+ * @param p_frame - frame to encode the converted colors into
+ */
+template<typename Format>
+void to_rgb(std::span<hsv const> p_colors,
+            ws2812b_spi_frame_view<Format> p_frame)
+{
+  auto const count = std::min(p_colors.size(), p_frame.pixel_count());
+  for (std::size_t i = 0; i < count; i++) {
+    p_frame.set(i, to_rgb(p_colors[i]));
+  }
+}
+
+/**
+ * @brief Convert HSV colors and encode them directly into a ws2812b frame
+ *
+ * @tparam PixelCount - The amount of pixels the frame holds.
+ * @tparam Format - The order of the color channels on the wire.
+ * @param p_colors - colors to convert, one per pixel starting at pixel 0
+ * @param p_frame - frame to encode the converted colors into
+ */
+template<std::size_t PixelCount, typename Format>
+void to_rgb(std::span<hsv const> p_colors,
+            ws2812b_spi_frame<PixelCount, Format>& p_frame)
+{
+  to_rgb(p_colors, ws2812b_spi_frame_view(p_frame));
+}
+
+/**
+ * @brief Convert HSL colors and encode them directly into a ws2812b frame
+ *
+ * Converts as many pixels as both spans hold.
+ *
+ * @tparam Format - The order of the color channels on the wire.
+ * @param p_colors - colors to convert, one per pixel starting at pixel 0
+ * @param p_frame - frame to encode the converted colors into
+ */
+template<typename Format>
+void to_rgb(std::span<hsl const> p_colors,
+            ws2812b_spi_frame_view<Format> p_frame)
+{
+  auto const count = std::min(p_colors.size(), p_frame.pixel_count());
+  for (std::size_t i = 0; i < count; i++) {
+    p_frame.set(i, to_rgb(p_colors[i]));
+  }
+}
+
+/**
+ * @brief Convert HSL colors and encode them directly into a ws2812b frame
+ *
+ * @tparam PixelCount - The amount of pixels the frame holds.
+ * @tparam Format - The order of the color channels on the wire.
+ * @param p_colors - colors to convert, one per pixel starting at pixel 0
+ * @param p_frame - frame to encode the converted colors into
+ */
+template<std::size_t PixelCount, typename Format>
+void to_rgb(std::span<hsl const> p_colors,
+            ws2812b_spi_frame<PixelCount, Format>& p_frame)
+{
+  to_rgb(p_colors, ws2812b_spi_frame_view(p_frame));
+}
+
+/**
+ * @brief Convert color temperatures and encode them directly into a ws2812b
+ * frame
+ *
+ * Converts as many pixels as both spans hold.
+ *
+ * @tparam Format - The order of the color channels on the wire.
+ * @param p_kelvin - color temperatures in kelvin, one per pixel starting at
+ * pixel 0
+ * @param p_frame - frame to encode the converted colors into
+ */
+template<typename Format>
+void kelvin_to_rgb(std::span<std::uint16_t const> p_kelvin,
+                   ws2812b_spi_frame_view<Format> p_frame)
+{
+  auto const count = std::min(p_kelvin.size(), p_frame.pixel_count());
+  for (std::size_t i = 0; i < count; i++) {
+    p_frame.set(i, kelvin_to_rgb(p_kelvin[i]));
+  }
+}
+
+/**
+ * @brief Convert color temperatures and encode them directly into a ws2812b
+ * frame
+ *
+ * @tparam PixelCount - The amount of pixels the frame holds.
+ * @tparam Format - The order of the color channels on the wire.
+ * @param p_kelvin - color temperatures in kelvin, one per pixel starting at
+ * pixel 0
+ * @param p_frame - frame to encode the converted colors into
+ */
+template<std::size_t PixelCount, typename Format>
+void kelvin_to_rgb(std::span<std::uint16_t const> p_kelvin,
+                   ws2812b_spi_frame<PixelCount, Format>& p_frame)
+{
+  kelvin_to_rgb(p_kelvin, ws2812b_spi_frame_view(p_frame));
+}
+
 /**
  * @brief Driver for the ws2812b individually addressable RGB LED strip
  *
+ * Also drives other one wire LEDs with the same timing, such as the SK6812
+ * RGBW, through frames of the matching pixel format.
  */
 class ws2812b
 {
@@ -79,16 +625,122 @@ public:
    * @brief Update the pixels to the currently stored color information.
    *
    * @tparam PixelCount - The amount of pixels the ws2812b device is using.
+   * @tparam Format - The order of the color channels on the wire.
    * @param p_spi_frame - The frame storing the pixels' color information.
    */
-  template<std::size_t PixelCount>
-  void update(ws2812b_spi_frame<PixelCount>& p_spi_frame)
+  template<std::size_t PixelCount, typename Format>
+  void update(ws2812b_spi_frame<PixelCount, Format>& p_spi_frame)
+  {
+    update(ws2812b_spi_frame_view(p_spi_frame));
+  }
+
+  /**
+   * @brief Update the pixels from a runtime sized frame.
+   *
+   * If the view reports its writes to a power meter, the frame is kept within
+   * the budget of that meter, see `update(p_frame, p_meter)`.
+   *
+   * @tparam Format - The order of the color channels on the wire.
+   * @param p_frame - view of the frame storing the pixels' color information.
+   */
+  template<typename Format>
+  void update(ws2812b_spi_frame_view<Format> p_frame)
+  {
+    if (p_frame.meter() != nullptr) {
+      update(p_frame, *p_frame.meter());
+      return;
+    }
+    transmit(p_frame.data());
+  }
+
+  /**
+   * @brief Update the pixels from read-only SPI encoded data.
+   *
+   * Sends the data as is without copying it, for example a frame built by
+   * `make_ws2812b_spi_frame()` and stored in flash.
+   *
+   * @param p_encoded_data - SPI encoded data of every pixel, in the format of
+   * `ws2812b_spi_frame::data`.
+   */
+  void update(std::span<hal::byte const> p_encoded_data)
+  {
+    transmit(p_encoded_data);
+  }
+
+  /**
+   * @brief Update the pixels from a planar working buffer.
+   *
+   * The planes are interleaved and encoded in small batches as the data is
+   * sent, in a single pass over the buffer. A white plane is only sent for
+   * formats with a white channel, and formats with a white channel send 0 for
+   * white if the buffer has no white plane. A brightness plane is ignored.
+   *
+   * @tparam Format - The order of the color channels on the wire.
+   * @param p_frame - planes holding the color of each pixel.
+   */
+  template<typename Format = grb_format>
+  void update(planar_frame_view p_frame)
+  {
+    using encoder = ws2812b_encoder<Format>;
+    // Encoding a batch takes a few microseconds, well within the 50us low time
+    // that would latch the LEDs early.
+    constexpr std::size_t batch_pixels = 8;
+    std::array<hal::byte, batch_pixels * encoder::bytes_per_pixel> batch{};
+
+    m_chip_select->level(false);
+    for (std::size_t first = 0; first < p_frame.pixel_count();
+         first += batch_pixels) {
+      auto const count = std::min(batch_pixels, p_frame.pixel_count() - first);
+      for (std::size_t i = 0; i < count; i++) {
+        auto* const destination = &batch[i * encoder::bytes_per_pixel];
+        if constexpr (Format::has_white) {
+          encoder::encode(destination, p_frame.get_rgbw(first + i));
+        } else {
+          encoder::encode(destination, p_frame.get(first + i));
+        }
+      }
+      hal::write(*m_spi,
+                 std::span(batch).first(count * encoder::bytes_per_pixel));
+    }
+    m_chip_select->level(true);
+  }
+
+  /**
+   * @brief Update the pixels while staying within a current budget.
+   *
+   * @tparam PixelCount - The amount of pixels the ws2812b device is using.
+   * @tparam Format - The order of the color channels on the wire.
+   * @param p_spi_frame - The frame storing the pixels' color information.
+   * @param p_meter - meter tracking the current draw of `p_spi_frame`.
+   */
+  template<std::size_t PixelCount, typename Format>
+  void update(ws2812b_spi_frame<PixelCount, Format>& p_spi_frame,
+              power_meter const& p_meter)
+  {
+    update(ws2812b_spi_frame_view(p_spi_frame), p_meter);
+  }
+
+  /**
+   * @brief Update the pixels while staying within a current budget.
+   *
+   * If the frame would draw more current than the budget of `p_meter`, every
+   * color channel is scaled by the same factor and re-encoded as the data is
+   * sent. The data stored in the frame is left unchanged.
+   *
+   * @tparam Format - The order of the color channels on the wire.
+   * @param p_frame - view of the frame storing the pixels' color information.
+   * @param p_meter - meter tracking the current draw of `p_frame`.
+   */
+  template<typename Format>
+  void update(ws2812b_spi_frame_view<Format> p_frame,
+              power_meter const& p_meter)
   {
-    update(p_spi_frame.data);
+    transmit(p_frame.data(), p_meter.scale(p_frame.pixel_count()));
   }
 
 private:
-  void update(std::span<hal::byte> p_data);
+  void transmit(std::span<hal::byte const> p_data);
+  void transmit(std::span<hal::byte const> p_data, hal::byte p_scale);
 
   hal::spi* m_spi;
   hal::output_pin* m_chip_select;
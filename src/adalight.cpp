@@ -0,0 +1,108 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <array>
+
+#include <libhal-display/adalight.hpp>
+
+namespace hal::display {
+
+void adalight_decoder::reset()
+{
+  m_state = state::magic_a;
+}
+
+adalight_decoder::event adalight_decoder::feed(hal::byte p_byte)
+{
+  switch (m_state) {
+    case state::red:
+      m_color.red = p_byte;
+      m_state = state::green;
+      return {};
+    case state::green:
+      m_color.green = p_byte;
+      m_state = state::blue;
+      return {};
+    case state::blue: {
+      m_color.blue = p_byte;
+      event result{
+        .index = m_index,
+        .color = m_color,
+        .has_pixel = true,
+        .frame_complete = m_index + 1 == m_pixel_count,
+      };
+      m_index++;
+      m_state = result.frame_complete ? state::magic_a : state::red;
+      return result;
+    }
+    default:
+      return feed_header(p_byte);
+  }
+}
+
+adalight_decoder::state adalight_decoder::restart(hal::byte p_byte)
+{
+  // A mismatched byte may itself be the start of the next header
+  return p_byte == 'A' ? state::magic_d : state::magic_a;
+}
+
+adalight_decoder::event adalight_decoder::feed_header(hal::byte p_byte)
+{
+  switch (m_state) {
+    case state::magic_a:
+      m_state = restart(p_byte);
+      break;
+    case state::magic_d:
+      m_state = p_byte == 'd' ? state::magic_a2 : restart(p_byte);
+      break;
+    case state::magic_a2:
+      m_state = p_byte == 'a' ? state::count_high : restart(p_byte);
+      break;
+    case state::count_high:
+      m_count_high = p_byte;
+      m_state = state::count_low;
+      break;
+    case state::count_low:
+      m_count_low = p_byte;
+      m_state = state::checksum;
+      break;
+    case state::checksum:
+      if (p_byte != (m_count_high ^ m_count_low ^ 0x55)) {
+        m_rejected_headers++;
+        m_state = state::magic_a;
+        break;
+      }
+      // The header holds the LED count minus one, so a frame is never empty
+      m_pixel_count = ((m_count_high << 8U) | m_count_low) + 1U;
+      m_index = 0;
+      m_state = state::red;
+      break;
+    default:
+      break;
+  }
+  return {};
+}
+
+adalight_receiver::adalight_receiver(hal::serial& p_serial)
+  : m_serial(&p_serial)
+  , m_source(p_serial)
+{
+}
+
+void adalight_receiver::announce()
+{
+  constexpr std::array<hal::byte, 4> greeting = { 'A', 'd', 'a', '\n' };
+  m_serial->write(greeting);
+}
+}  // namespace hal::display
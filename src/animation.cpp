@@ -0,0 +1,201 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+#include <libhal-display/animation.hpp>
+#include <libhal/error.hpp>
+
+namespace hal::display {
+
+void animation_decoder::reset()
+{
+  m_state = state::header;
+  m_received = 0;
+}
+
+animation_decoder::event animation_decoder::feed(hal::byte p_byte)
+{
+  switch (m_state) {
+    case state::header:
+      return feed_header(p_byte);
+    case state::frame_type:
+      return start_frame(p_byte);
+    case state::run_length:
+      m_remaining = p_byte + 1U;
+      m_state = state::run_pixel;
+      return {};
+    case state::delta_skip:
+      m_index += p_byte;
+      m_state = state::delta_length;
+      return {};
+    case state::delta_length: {
+      m_remaining = p_byte;
+      if (m_remaining != 0) {
+        m_state = state::delta_pixel;
+        return {};
+      }
+      event result{};
+      end_run(result);
+      return result;
+    }
+    case state::raw_pixel:
+    case state::run_pixel:
+    case state::delta_pixel:
+    default:
+      return feed_pixel(p_byte);
+  }
+}
+
+animation_decoder::event animation_decoder::feed_header(hal::byte p_byte)
+{
+  constexpr std::array<hal::byte, 4> magic = { 'L', 'H', 'A', 'N' };
+  constexpr hal::byte version = 1;
+
+  m_header_bytes[m_received++] = p_byte;
+  if (m_received < header_size) {
+    return {};
+  }
+
+  // Start over on the next byte whether or not the header is valid, so a
+  // caller that recovers from the error can keep feeding bytes
+  m_received = 0;
+
+  auto const& bytes = m_header_bytes;
+  if (!std::equal(magic.begin(), magic.end(), bytes.begin()) ||
+      bytes[4] != version || (bytes[5] != 3 && bytes[5] != 4)) {
+    throw hal::io_error(this);
+  }
+
+  m_header = {
+    .channels = bytes[5],
+    .pixel_count = static_cast<std::uint16_t>(bytes[6] | (bytes[7] << 8)),
+    .frame_period_ms = static_cast<std::uint16_t>(bytes[8] | (bytes[9] << 8)),
+  };
+  m_state = state::frame_type;
+  return {};
+}
+
+animation_decoder::event animation_decoder::start_frame(hal::byte p_type)
+{
+  m_frame_type = static_cast<frame_type>(p_type);
+  m_index = 0;
+  m_received = 0;
+
+  switch (m_frame_type) {
+    case frame_type::raw:
+      m_state = state::raw_pixel;
+      break;
+    case frame_type::run_length:
+      m_state = state::run_length;
+      break;
+    case frame_type::delta:
+      m_state = state::delta_skip;
+      break;
+    default:
+      throw hal::io_error(this);
+  }
+
+  event result{};
+  if (m_header.pixel_count == 0) {
+    result.frame_complete = true;
+    m_state = state::frame_type;
+  }
+  return result;
+}
+
+animation_decoder::event animation_decoder::feed_pixel(hal::byte p_byte)
+{
+  switch (m_received++) {
+    case 0:
+      m_color = { .red = p_byte };
+      break;
+    case 1:
+      m_color.green = p_byte;
+      break;
+    case 2:
+      m_color.blue = p_byte;
+      break;
+    default:
+      m_color.white = p_byte;
+      break;
+  }
+
+  if (m_received < m_header.channels) {
+    return {};
+  }
+  m_received = 0;
+
+  switch (m_state) {
+    case state::raw_pixel: {
+      auto result = emit(1);
+      if (m_index >= m_header.pixel_count) {
+        result.frame_complete = true;
+        m_state = state::frame_type;
+      }
+      return result;
+    }
+    case state::run_pixel: {
+      auto result = emit(m_remaining);
+      end_run(result);
+      return result;
+    }
+    case state::delta_pixel:
+    default: {
+      auto result = emit(1);
+      m_remaining--;
+      if (m_remaining == 0) {
+        end_run(result);
+      }
+      return result;
+    }
+  }
+}
+
+animation_decoder::event animation_decoder::emit(std::size_t p_count)
+{
+  event result{ .index = m_index, .color = m_color };
+  if (m_index < m_header.pixel_count) {
+    result.count =
+      std::min<std::size_t>(p_count, m_header.pixel_count - m_index);
+  }
+  m_index += p_count;
+  return result;
+}
+
+void animation_decoder::end_run(event& p_event)
+{
+  if (m_index >= m_header.pixel_count) {
+    p_event.frame_complete = true;
+    m_state = state::frame_type;
+  } else if (m_frame_type == frame_type::run_length) {
+    m_state = state::run_length;
+  } else {
+    m_state = state::delta_skip;
+  }
+}
+
+animation_player::animation_player(frame_source& p_source)
+  : m_source(&p_source)
+{
+}
+
+void animation_player::reset()
+{
+  m_decoder.reset();
+  m_pump.discard();
+}
+}  // namespace hal::display
@@ -2,9 +2,59 @@
 
 #include <libhal-util/as_bytes.hpp>
 #include <libhal-util/spi.hpp>
+#include <libhal/error.hpp>
+#include <algorithm>
 #include <span>
 
 namespace hal::display {
+namespace {
+template<typename Color, typename Converter>
+void convert(std::span<Color const> p_colors,
+             apa102_frame_view p_frame,
+             Converter p_converter)
+{
+  auto const count = std::min(p_colors.size(), p_frame.pixel_count());
+  for (std::size_t i = 0; i < count; i++) {
+    p_frame.set(i, p_converter(p_colors[i]));
+  }
+}
+
+void write_end_frame(hal::spi& p_spi, std::size_t p_pixel_count)
+{
+  std::array<hal::byte, 4> const ones = { 0xFF, 0xFF, 0xFF, 0xFF };
+  for (std::size_t sent = 0; sent < apa102_end_frame_size(p_pixel_count);
+       sent += ones.size()) {
+    hal::write(p_spi, ones);
+  }
+}
+}  // namespace
+
+apa102_frame_view::apa102_frame_view(std::span<apa102_pixel> p_buffer,
+                                     std::size_t p_pixel_count)
+{
+  if (p_pixel_count > p_buffer.size()) {
+    throw hal::argument_out_of_domain(this);
+  }
+  m_pixels = p_buffer.first(p_pixel_count);
+}
+
+void to_rgb(std::span<hsv const> p_colors, apa102_frame_view p_frame)
+{
+  convert(p_colors, p_frame, [](hsv p_color) { return to_rgb(p_color); });
+}
+
+void to_rgb(std::span<hsl const> p_colors, apa102_frame_view p_frame)
+{
+  convert(p_colors, p_frame, [](hsl p_color) { return to_rgb(p_color); });
+}
+
+void kelvin_to_rgb(std::span<std::uint16_t const> p_kelvin,
+                   apa102_frame_view p_frame)
+{
+  convert(p_kelvin, p_frame, [](std::uint16_t p_temperature) {
+    return kelvin_to_rgb(p_temperature);
+  });
+}
 
 apa102::apa102(hal::spi& p_spi, hal::output_pin& p_chip_select)
   : m_spi(&p_spi)
@@ -15,12 +65,88 @@ apa102::apa102(hal::spi& p_spi, hal::output_pin& p_chip_select)
 }
 
 // public
-void apa102::update(std::span<apa102_pixel> p_pixels)
+void apa102::update(apa102_frame_view p_frame)
 {
+  if (p_frame.meter() != nullptr) {
+    update(p_frame, *p_frame.meter());
+    return;
+  }
+
+  m_chip_select->level(false);
+  hal::write(*m_spi, std::array<hal::byte, 4>{ 0x00, 0x00, 0x00, 0x00 });
+  hal::write(*m_spi, hal::as_bytes(p_frame.pixels()));
+  write_end_frame(*m_spi, p_frame.pixel_count());
+  m_chip_select->level(true);
+}
+
+void apa102::update(planar_frame_view p_frame)
+{
+  std::array<apa102_pixel, 16> batch{};
+  auto const brightness = p_frame.brightness();
+  auto const red = p_frame.red();
+  auto const green = p_frame.green();
+  auto const blue = p_frame.blue();
+
+  m_chip_select->level(false);
+  hal::write(*m_spi, std::array<hal::byte, 4>{ 0x00, 0x00, 0x00, 0x00 });
+  for (std::size_t first = 0; first < p_frame.pixel_count();
+       first += batch.size()) {
+    auto const count = std::min(batch.size(), p_frame.pixel_count() - first);
+    for (std::size_t i = 0; i < count; i++) {
+      auto const index = first + i;
+      batch[i] = {
+        .brightness =
+          brightness.empty()
+            ? hal::byte{ 0xFF }
+            : static_cast<hal::byte>(0xE0 | (brightness[index] & 0x1F)),
+        .blue = blue[index],
+        .green = green[index],
+        .red = red[index],
+      };
+    }
+    hal::write(*m_spi, hal::as_bytes(std::span(batch).first(count)));
+  }
+  write_end_frame(*m_spi, p_frame.pixel_count());
+  m_chip_select->level(true);
+}
+
+void apa102::update(std::span<hal::byte const> p_stream)
+{
+  m_chip_select->level(false);
+  hal::write(*m_spi, p_stream);
+  m_chip_select->level(true);
+}
+
+void apa102::update(apa102_frame_view p_frame, power_meter const& p_meter)
+{
+  auto const scale = p_meter.scale(p_frame.pixel_count());
+
+  if (scale == 255) {
+    update(apa102_frame_view(p_frame.pixels()));
+    return;
+  }
+
+  // Scale the pixels in small batches as they are sent so the frame itself is
+  // left untouched and no second frame buffer is needed.
+  std::array<apa102_pixel, 16> batch{};
+  auto pixels = p_frame.pixels();
+
   m_chip_select->level(false);
   hal::write(*m_spi, std::array<hal::byte, 4>{ 0x00, 0x00, 0x00, 0x00 });
-  hal::write(*m_spi, hal::as_bytes(p_pixels));
-  hal::write(*m_spi, std::array<hal::byte, 4>{ 0xFF, 0xFF, 0xFF, 0xFF });
+  while (!pixels.empty()) {
+    auto const count = std::min(pixels.size(), batch.size());
+    for (std::size_t i = 0; i < count; i++) {
+      batch[i] = {
+        .brightness = pixels[i].brightness,
+        .blue = scale_channel(pixels[i].blue, scale),
+        .green = scale_channel(pixels[i].green, scale),
+        .red = scale_channel(pixels[i].red, scale),
+      };
+    }
+    hal::write(*m_spi, hal::as_bytes(std::span(batch).first(count)));
+    pixels = pixels.subspan(count);
+  }
+  write_end_frame(*m_spi, p_frame.pixel_count());
   m_chip_select->level(true);
 }
 }  // namespace hal::display
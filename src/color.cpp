@@ -0,0 +1,191 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+
+#include <libhal-display/color.hpp>
+
+namespace hal::display {
+namespace {
+// Tanner Helland's color temperature fit sampled every 100K from 1000K to
+// 6600K.
+constexpr std::uint16_t low_kelvin_start = 1000;
+constexpr std::uint16_t low_kelvin_step = 100;
+constexpr std::array<rgb888, 57> low_kelvin_table{ {
+  { 255, 68, 0 },    { 255, 77, 0 },    { 255, 86, 0 },    { 255, 94, 0 },
+  { 255, 101, 0 },   { 255, 108, 0 },   { 255, 115, 0 },   { 255, 121, 0 },
+  { 255, 126, 0 },   { 255, 132, 0 },   { 255, 137, 14 },  { 255, 142, 27 },
+  { 255, 146, 39 },  { 255, 151, 50 },  { 255, 155, 61 },  { 255, 159, 70 },
+  { 255, 163, 79 },  { 255, 167, 87 },  { 255, 170, 95 },  { 255, 174, 103 },
+  { 255, 177, 110 }, { 255, 180, 117 }, { 255, 184, 123 }, { 255, 187, 129 },
+  { 255, 190, 135 }, { 255, 193, 141 }, { 255, 195, 146 }, { 255, 198, 151 },
+  { 255, 201, 157 }, { 255, 203, 161 }, { 255, 206, 166 }, { 255, 208, 171 },
+  { 255, 211, 175 }, { 255, 213, 179 }, { 255, 215, 183 }, { 255, 218, 187 },
+  { 255, 220, 191 }, { 255, 222, 195 }, { 255, 224, 199 }, { 255, 226, 202 },
+  { 255, 228, 206 }, { 255, 230, 209 }, { 255, 232, 213 }, { 255, 234, 216 },
+  { 255, 236, 219 }, { 255, 237, 222 }, { 255, 239, 225 }, { 255, 241, 228 },
+  { 255, 243, 231 }, { 255, 244, 234 }, { 255, 246, 237 }, { 255, 248, 240 },
+  { 255, 249, 242 }, { 255, 251, 245 }, { 255, 253, 248 }, { 255, 254, 250 },
+  { 255, 255, 255 },
+} };
+
+// Above 6600K the curve flattens in kelvin but is close to linear in mireds
+// (1,000,000 / kelvin), so it is sampled every 4 mireds from 24 to 152 mireds.
+constexpr std::uint32_t high_mired_start = 24;
+constexpr std::uint32_t high_mired_step = 4;
+constexpr std::array<rgb888, 33> high_kelvin_table{ {
+  { 151, 185, 255 }, { 154, 187, 255 }, { 158, 190, 255 }, { 161, 192, 255 },
+  { 164, 194, 255 }, { 167, 196, 255 }, { 169, 198, 255 }, { 172, 199, 255 },
+  { 175, 201, 255 }, { 177, 203, 255 }, { 179, 204, 255 }, { 182, 206, 255 },
+  { 184, 207, 255 }, { 187, 209, 255 }, { 189, 210, 255 }, { 192, 212, 255 },
+  { 194, 213, 255 }, { 196, 215, 255 }, { 199, 216, 255 }, { 202, 218, 255 },
+  { 204, 220, 255 }, { 207, 221, 255 }, { 210, 223, 255 }, { 213, 225, 255 },
+  { 217, 227, 255 }, { 220, 229, 255 }, { 224, 232, 255 }, { 228, 234, 255 },
+  { 233, 237, 255 }, { 238, 240, 255 }, { 244, 243, 255 }, { 252, 247, 255 },
+  { 255, 252, 255 },
+} };
+
+hal::byte lerp_channel(hal::byte p_from,
+                       hal::byte p_to,
+                       std::uint32_t p_amount)
+{
+  // p_amount is a fraction of 256
+  auto const blended = p_from * (256U - p_amount) + p_to * p_amount + 128U;
+  return static_cast<hal::byte>(blended >> 8U);
+}
+
+template<std::size_t table_size>
+rgb888 interpolate(std::array<rgb888, table_size> const& p_table,
+                   std::uint32_t p_index,
+                   std::uint32_t p_amount)
+{
+  auto const& from = p_table[p_index];
+  auto const& to = p_table[std::min<std::size_t>(p_index + 1, table_size - 1)];
+  return {
+    .red = lerp_channel(from.red, to.red, p_amount),
+    .green = lerp_channel(from.green, to.green, p_amount),
+    .blue = lerp_channel(from.blue, to.blue, p_amount),
+  };
+}
+}  // namespace
+
+rgb888 to_rgb(hsv p_color)
+{
+  hal::byte const value = p_color.value;
+  hal::byte const saturation = p_color.saturation;
+
+  if (saturation == 0) {
+    return { .red = value, .green = value, .blue = value };
+  }
+
+  // Upper bits hold the sector of the color wheel (0 to 5) and the next 8 bits
+  // hold the position within that sector.
+  std::uint32_t const scaled_hue = p_color.hue * 6U;
+  auto const sector = scaled_hue >> 16U;
+  auto const fraction = static_cast<hal::byte>(scaled_hue >> 8U);
+
+  hal::byte const p = scale_channel(value, 255 - saturation);
+  hal::byte const q =
+    scale_channel(value, 255 - scale_channel(saturation, fraction));
+  hal::byte const t =
+    scale_channel(value, 255 - scale_channel(saturation, 255 - fraction));
+
+  switch (sector) {
+    case 0:
+      return { .red = value, .green = t, .blue = p };
+    case 1:
+      return { .red = q, .green = value, .blue = p };
+    case 2:
+      return { .red = p, .green = value, .blue = t };
+    case 3:
+      return { .red = p, .green = q, .blue = value };
+    case 4:
+      return { .red = t, .green = p, .blue = value };
+    default:
+      return { .red = value, .green = p, .blue = q };
+  }
+}
+
+rgb888 to_rgb(hsl p_color)
+{
+  hal::byte const lightness = p_color.lightness;
+
+  if (p_color.saturation == 0) {
+    return { .red = lightness, .green = lightness, .blue = lightness };
+  }
+
+  // chroma = (1 - |2L - 1|) * S
+  int const distance_from_middle = 2 * lightness - 255;
+  auto const max_chroma =
+    static_cast<hal::byte>(255 - std::abs(distance_from_middle));
+  int const chroma = scale_channel(max_chroma, p_color.saturation);
+
+  std::uint32_t const scaled_hue = p_color.hue * 6U;
+  auto const sector = scaled_hue >> 16U;
+  auto const fraction = static_cast<hal::byte>(scaled_hue >> 8U);
+  // The secondary component rises in even sectors and falls in odd sectors.
+  int const secondary = scale_channel(
+    static_cast<hal::byte>(chroma),
+    (sector & 1U) ? static_cast<hal::byte>(255 - fraction) : fraction);
+
+  // Work in units of half a count so the midpoint (L - chroma / 2) is exact
+  int const doubled_minimum = 2 * lightness - chroma;
+  auto const channel = [doubled_minimum](int p_component) -> hal::byte {
+    return static_cast<hal::byte>((doubled_minimum + 2 * p_component + 1) / 2);
+  };
+
+  switch (sector) {
+    case 0:
+      return { channel(chroma), channel(secondary), channel(0) };
+    case 1:
+      return { channel(secondary), channel(chroma), channel(0) };
+    case 2:
+      return { channel(0), channel(chroma), channel(secondary) };
+    case 3:
+      return { channel(0), channel(secondary), channel(chroma) };
+    case 4:
+      return { channel(secondary), channel(0), channel(chroma) };
+    default:
+      return { channel(chroma), channel(0), channel(secondary) };
+  }
+}
+
+rgb888 kelvin_to_rgb(std::uint16_t p_kelvin)
+{
+  constexpr std::uint16_t min_kelvin = 1000;
+  constexpr std::uint16_t max_kelvin = 40000;
+  constexpr std::uint16_t boundary_kelvin = 6600;
+
+  auto const kelvin = std::clamp(p_kelvin, min_kelvin, max_kelvin);
+
+  if (kelvin <= boundary_kelvin) {
+    std::uint32_t const offset = kelvin - low_kelvin_start;
+    std::uint32_t const index = offset / low_kelvin_step;
+    std::uint32_t const amount =
+      ((offset % low_kelvin_step) * 256U) / low_kelvin_step;
+    return interpolate(low_kelvin_table, index, amount);
+  }
+
+  // Mireds with 8 fractional bits
+  std::uint32_t const mired = (1'000'000U * 256U) / kelvin;
+  std::uint32_t const offset = mired - (high_mired_start * 256U);
+  std::uint32_t const index = offset / (high_mired_step * 256U);
+  std::uint32_t const amount =
+    (offset % (high_mired_step * 256U)) / high_mired_step;
+  return interpolate(high_kelvin_table, index, amount);
+}
+}  // namespace hal::display
@@ -0,0 +1,52 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+
+#include <libhal-display/frame_source.hpp>
+
+namespace hal::display {
+
+serial_frame_source::serial_frame_source(hal::serial& p_serial)
+  : m_serial(&p_serial)
+{
+}
+
+std::span<hal::byte> serial_frame_source::driver_read(
+  std::span<hal::byte> p_buffer)
+{
+  return m_serial->read(p_buffer).data;
+}
+
+memory_frame_source::memory_frame_source(
+  std::span<hal::byte const> p_animation)
+  : m_animation(p_animation)
+{
+}
+
+void memory_frame_source::rewind()
+{
+  m_position = 0;
+}
+
+std::span<hal::byte> memory_frame_source::driver_read(
+  std::span<hal::byte> p_buffer)
+{
+  auto const remaining = m_animation.subspan(m_position);
+  auto const count = std::min(remaining.size(), p_buffer.size());
+  std::copy_n(remaining.begin(), count, p_buffer.begin());
+  m_position += count;
+  return p_buffer.first(count);
+}
+}  // namespace hal::display
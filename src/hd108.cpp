@@ -0,0 +1,49 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <array>
+
+#include <libhal-display/hd108.hpp>
+#include <libhal-util/as_bytes.hpp>
+#include <libhal-util/spi.hpp>
+
+namespace hal::display {
+
+hd108::hd108(hal::spi& p_spi, hal::output_pin& p_chip_select)
+  : m_spi(&p_spi)
+  , m_chip_select(&p_chip_select)
+{
+  // Same rate as the apa102, well below the hd108 maximum, so long runs of
+  // wire stay reliable
+  m_spi->configure(hal::spi::settings{ 1.0_MHz, { false }, { false } });
+}
+
+void hd108::update(hd108_frame_view p_frame)
+{
+  // Each pixel passes its data on one clock edge late, so the end frame needs
+  // at least one clock for every two pixels.
+  std::array<hal::byte, 4> const ones = { 0xFF, 0xFF, 0xFF, 0xFF };
+  auto const end_bytes = (p_frame.pixel_count() + 15U) / 16U;
+
+  m_chip_select->level(false);
+  hal::write(*m_spi, std::array<hal::byte, 16>{});
+  hal::write(*m_spi, hal::as_bytes(p_frame.pixels()));
+  for (std::size_t sent = 0; sent < std::max<std::size_t>(end_bytes, 4U);
+       sent += ones.size()) {
+    hal::write(*m_spi, ones);
+  }
+  m_chip_select->level(true);
+}
+}  // namespace hal::display
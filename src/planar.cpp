@@ -0,0 +1,42 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <libhal-display/planar.hpp>
+
+#include <libhal/error.hpp>
+
+namespace hal::display {
+planar_frame_view::planar_frame_view(std::span<hal::byte> p_red,
+                                     std::span<hal::byte> p_green,
+                                     std::span<hal::byte> p_blue,
+                                     std::span<hal::byte> p_white,
+                                     std::span<hal::byte> p_brightness)
+{
+  auto const count = p_red.size();
+  auto const optional_fits = [count](std::span<hal::byte> p_plane) {
+    return p_plane.empty() || p_plane.size() >= count;
+  };
+
+  if (p_green.size() < count || p_blue.size() < count ||
+      !optional_fits(p_white) || !optional_fits(p_brightness)) {
+    throw hal::argument_out_of_domain(this);
+  }
+
+  m_red = p_red;
+  m_green = p_green.first(count);
+  m_blue = p_blue.first(count);
+  m_white = p_white.first(std::min(count, p_white.size()));
+  m_brightness = p_brightness.first(std::min(count, p_brightness.size()));
+}
+}  // namespace hal::display
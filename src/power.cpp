@@ -0,0 +1,63 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+
+#include <libhal-display/power.hpp>
+
+namespace hal::display {
+
+power_meter::power_meter(power_model p_model)
+  : m_model(p_model)
+{
+}
+
+std::uint32_t power_meter::milliamps(std::size_t p_pixel_count) const
+{
+  std::uint64_t const idle =
+    std::uint64_t{ m_model.idle_milliamps_per_pixel } * p_pixel_count;
+  std::uint64_t const channels =
+    std::uint64_t{ m_load } * m_model.milliamps_per_channel;
+  // Round up so the estimate never under reports the draw
+  return static_cast<std::uint32_t>(
+    idle + (channels + full_channel_load - 1) / full_channel_load);
+}
+
+hal::byte power_meter::scale(std::size_t p_pixel_count) const
+{
+  if (m_model.budget_milliamps == 0) {
+    return 255;
+  }
+
+  std::uint64_t const idle =
+    std::uint64_t{ m_model.idle_milliamps_per_pixel } * p_pixel_count;
+
+  if (idle >= m_model.budget_milliamps) {
+    return 0;
+  }
+
+  // Both values are in units of (1 / full_channel_load) milliamps
+  std::uint64_t const available =
+    (m_model.budget_milliamps - idle) * full_channel_load;
+  std::uint64_t const channels =
+    std::uint64_t{ m_load } * m_model.milliamps_per_channel;
+
+  if (channels <= available) {
+    return 255;
+  }
+
+  // Round down so the scaled frame stays within the budget
+  return static_cast<hal::byte>((available * 255U) / channels);
+}
+}  // namespace hal::display
@@ -12,6 +12,9 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
+#include <array>
+
 #include <libhal-display/ws2812b.hpp>
 #include <libhal-util/spi.hpp>
 
@@ -24,11 +27,42 @@ ws2812b::ws2812b(hal::spi& p_spi, hal::output_pin& p_chip_select)
   m_spi->configure(hal::spi::settings{ 4.0_MHz, { false }, { false } });
 }
 
-void ws2812b::update(std::span<hal::byte> p_data)
+void ws2812b::transmit(std::span<hal::byte const> p_data)
 {
   m_chip_select->level(false);
   hal::write(*m_spi, p_data);
   m_chip_select->level(true);
 }
 
+void ws2812b::transmit(std::span<hal::byte const> p_data, hal::byte p_scale)
+{
+  if (p_scale == 255) {
+    transmit(p_data);
+    return;
+  }
+
+  // Every channel is encoded the same way regardless of the pixel format, so
+  // the data is handled one channel at a time.
+  using encoder = ws2812b_encoder<>;
+  constexpr auto channel_bytes = encoder::bytes_per_channel;
+
+  // Re-encode the scaled channels in small batches as they are sent so the
+  // frame itself is left untouched. A batch takes ~200us to shift out at 4MHz
+  // while preparing the next takes only a few microseconds, well within the
+  // 50us low time that would latch the LEDs early.
+  std::array<hal::byte, 24 * channel_bytes> batch{};
+
+  m_chip_select->level(false);
+  while (!p_data.empty()) {
+    auto const count = std::min(p_data.size(), batch.size());
+    for (std::size_t i = 0; i < count; i += channel_bytes) {
+      auto const value = encoder::decode_channel(&p_data[i]);
+      encoder::encode_channel(&batch[i], scale_channel(value, p_scale));
+    }
+    hal::write(*m_spi, std::span(batch).first(count));
+    p_data = p_data.subspan(count);
+  }
+  m_chip_select->level(true);
+}
+
 }  // namespace hal::display
@@ -0,0 +1,207 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <libhal-display/adalight.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <vector>
+
+#include <libhal-display/apa102.hpp>
+#include <libhal-display/ws2812b.hpp>
+#include <libhal-util/mock/spi.hpp>
+
+#include <boost/ut.hpp>
+
+namespace hal::display {
+namespace {
+std::vector<hal::byte> make_frame(std::span<rgb888 const> p_pixels)
+{
+  auto const count = p_pixels.size() - 1;
+  auto const high = static_cast<hal::byte>(count >> 8);
+  auto const low = static_cast<hal::byte>(count);
+  std::vector<hal::byte> frame = {
+    'A', 'd', 'a', high, low, static_cast<hal::byte>(high ^ low ^ 0x55),
+  };
+  for (auto const& pixel : p_pixels) {
+    frame.insert(frame.end(), { pixel.red, pixel.green, pixel.blue });
+  }
+  return frame;
+}
+
+/// Serial port that hands out a prerecorded stream at most a few bytes at a
+/// time, as a UART would, and records everything written to it
+class mock_serial : public hal::serial
+{
+public:
+  mock_serial(std::span<hal::byte const> p_stream, std::size_t p_max_read)
+    : m_stream(p_stream)
+    , m_max_read(p_max_read)
+  {
+  }
+
+  std::vector<hal::byte> written{};
+
+private:
+  void driver_configure(settings const&) override
+  {
+  }
+
+  write_t driver_write(std::span<hal::byte const> p_data) override
+  {
+    written.insert(written.end(), p_data.begin(), p_data.end());
+    return { .data = p_data };
+  }
+
+  read_t driver_read(std::span<hal::byte> p_data) override
+  {
+    auto const count =
+      std::min({ p_data.size(), m_stream.size(), m_max_read });
+    std::copy_n(m_stream.begin(), count, p_data.begin());
+    m_stream = m_stream.subspan(count);
+    return {
+      .data = p_data.first(count),
+      .available = m_stream.size(),
+      .capacity = m_max_read,
+    };
+  }
+
+  void driver_flush() override
+  {
+    m_stream = {};
+  }
+
+  std::span<hal::byte const> m_stream;
+  std::size_t m_max_read;
+};
+}  // namespace
+
+boost::ut::suite<"adalight_test"> adalight_test = [] {
+  using namespace boost::ut;
+
+  "adalight_receiver writes pixels into the frame"_test = []() {
+    // Setup
+    std::array<rgb888, 3> const pixels = {
+      { { 1, 2, 3 }, { 4, 5, 6 }, { 7, 8, 9 } }
+    };
+    auto const stream = make_frame(pixels);
+    mock_serial serial(stream, 5);
+    adalight_receiver receiver(serial);
+    apa102_frame<3> frame{};
+
+    // Exercise
+    receiver.announce();
+    auto const complete = receiver.poll(apa102_frame_view(frame));
+    auto const complete_again = receiver.poll(apa102_frame_view(frame));
+
+    // Verify
+    expect(std::vector<hal::byte>{ 'A', 'd', 'a', '\n' } == serial.written);
+    expect(that % true == complete);
+    expect(that % false == complete_again);
+    expect(that % 7U == frame.pixels[2].red);
+    expect(that % 8U == frame.pixels[2].green);
+    expect(that % 9U == frame.pixels[2].blue);
+    expect(that % 0xFF == frame.pixels[2].brightness);
+    expect(that % stream.size() == receiver.bytes_received());
+    expect(that % 1U == receiver.frames_received());
+  };
+
+  "adalight_decoder resynchronizes after noise and bad headers"_test = []() {
+    // Setup
+    std::array<rgb888, 2> const pixels = { { { 10, 20, 30 }, { 40, 50, 60 } } };
+    std::vector<hal::byte> stream = { 0x00, 'A', 'd', 'A', 'd', 'a', 0x00,
+                                      0x01, 0x00 /* bad checksum */ };
+    auto const frame_bytes = make_frame(pixels);
+    stream.insert(stream.end(), { 0x12, 'A', 'A' });
+    stream.insert(stream.end(), frame_bytes.begin(), frame_bytes.end());
+    adalight_decoder decoder;
+    std::vector<adalight_decoder::event> events;
+
+    // Exercise
+    for (auto const byte : stream) {
+      auto const event = decoder.feed(byte);
+      if (event.has_pixel) {
+        events.push_back(event);
+      }
+    }
+
+    // Verify
+    expect(that % 1U == decoder.rejected_headers());
+    expect(that % 2U == events.size());
+    expect(rgb888{ 10, 20, 30 } == events[0].color);
+    expect(that % false == events[0].frame_complete);
+    expect(that % 1U == events[1].index);
+    expect(rgb888{ 40, 50, 60 } == events[1].color);
+    expect(that % true == events[1].frame_complete);
+  };
+
+  "adalight_receiver encodes into ws2812b frames and updates"_test = []() {
+    // Setup
+    std::array<rgb888, 4> const pixels = {
+      { { 1, 2, 3 }, { 4, 5, 6 }, { 7, 8, 9 }, { 10, 11, 12 } }
+    };
+    auto const stream = make_frame(pixels);
+    mock_serial serial(stream, 64);
+    hal::mock_write_only_spi spi;
+    ws2812b driver(spi);
+    adalight_receiver receiver(serial);
+    // The strip is shorter than the frames sent by the PC
+    ws2812b_spi_frame<3> frame{};
+    ws2812b_spi_frame_view view(frame);
+
+    // Exercise
+    auto const complete = receiver.poll(view, driver);
+
+    // Verify
+    expect(that % true == complete);
+    expect(rgb888{ 7, 8, 9 } == view.get(2));
+    expect(that % 1U == spi.write_record.size());
+    expect(std::ranges::equal(frame.data, spi.write_record[0]));
+  };
+
+  "adalight_receiver streams many frames"_test = []() {
+    // Setup
+    constexpr std::size_t pixel_count = 300;
+    constexpr std::size_t frame_count = 50;
+    std::vector<rgb888> pixels(pixel_count);
+    std::vector<hal::byte> stream;
+    for (std::size_t i = 0; i < frame_count; i++) {
+      std::ranges::fill(pixels, rgb888{ static_cast<hal::byte>(i), 0, 0 });
+      auto const frame_bytes = make_frame(pixels);
+      stream.insert(stream.end(), frame_bytes.begin(), frame_bytes.end());
+    }
+    mock_serial serial(stream, adalight_receiver::chunk_size);
+    adalight_receiver receiver(serial);
+    ws2812b_spi_frame<pixel_count> frame{};
+
+    // Exercise
+    auto const start = std::chrono::steady_clock::now();
+    while (receiver.poll(ws2812b_spi_frame_view(frame))) {
+    }
+    auto const elapsed = std::chrono::steady_clock::now() - start;
+
+    // Verify
+    expect(that % frame_count == receiver.frames_received());
+    expect(that % stream.size() == receiver.bytes_received());
+    expect(rgb888{ frame_count - 1, 0, 0 } ==
+           ws2812b_spi_frame_view(frame).get(pixel_count - 1));
+    // Reported rather than checked, as wall clock time depends on the host.
+    // Compare against the 400'000 bytes per second of a 4 Mbaud UART.
+    auto const seconds = std::chrono::duration<double>(elapsed).count();
+    boost::ut::log << "adalight throughput: " << stream.size() / seconds
+                   << " bytes per second\n";
+  };
+};
+}  // namespace hal::display
@@ -0,0 +1,217 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <libhal-display/animation.hpp>
+
+#include <algorithm>
+#include <vector>
+
+#include <libhal-display/apa102.hpp>
+#include <libhal-display/ws2812b.hpp>
+
+#include <boost/ut.hpp>
+
+namespace hal::display {
+namespace {
+std::vector<hal::byte> make_header(hal::byte p_channels,
+                                   std::uint16_t p_pixel_count)
+{
+  return { 'L',
+           'H',
+           'A',
+           'N',
+           1,
+           p_channels,
+           static_cast<hal::byte>(p_pixel_count),
+           static_cast<hal::byte>(p_pixel_count >> 8),
+           33,
+           0 };
+}
+
+// Hands out a few bytes on every other read, like a slow serial port that has
+// not yet received the rest of a frame
+class trickle_frame_source : public frame_source
+{
+public:
+  trickle_frame_source(std::span<hal::byte const> p_animation,
+                       std::size_t p_max_read)
+    : m_source(p_animation)
+    , m_max_read(p_max_read)
+  {
+  }
+
+private:
+  std::span<hal::byte> driver_read(std::span<hal::byte> p_buffer) override
+  {
+    m_starved = !m_starved;
+    if (m_starved) {
+      return {};
+    }
+    return m_source.read(p_buffer.first(std::min(p_buffer.size(), m_max_read)));
+  }
+
+  memory_frame_source m_source;
+  std::size_t m_max_read;
+  bool m_starved = true;
+};
+}  // namespace
+
+boost::ut::suite<"animation_test"> animation_test = [] {
+  using namespace boost::ut;
+
+  "animation_player plays raw, run length and delta frames"_test = []() {
+    // Setup
+    auto animation = make_header(3, 4);
+    // raw
+    animation.insert(animation.end(),
+                     { 0x00, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12 });
+    // run length: 3 pixels of (20, 21, 22) then 1 of (30, 31, 32)
+    animation.insert(animation.end(),
+                     { 0x01, 2, 20, 21, 22, 0, 30, 31, 32 });
+    // delta: skip 1, replace 1 with (40, 41, 42), skip 2, replace none
+    animation.insert(animation.end(), { 0x02, 1, 1, 40, 41, 42, 2, 0 });
+    memory_frame_source source(animation);
+    animation_player player(source);
+    apa102_frame<4> frame{};
+    apa102_frame_view view(frame);
+    auto const color_at = [&frame](std::size_t p_index) {
+      auto const& pixel = frame.pixels[p_index];
+      return rgb888{ pixel.red, pixel.green, pixel.blue };
+    };
+
+    // Exercise & Verify
+    expect(player.poll(view));
+    expect(that % 4U == player.header().pixel_count);
+    expect(that % 33U == player.header().frame_period_ms);
+    expect(rgb888{ 1, 2, 3 } == color_at(0));
+    expect(rgb888{ 10, 11, 12 } == color_at(3));
+
+    expect(player.poll(view));
+    expect(rgb888{ 20, 21, 22 } == color_at(0));
+    expect(rgb888{ 20, 21, 22 } == color_at(2));
+    expect(rgb888{ 30, 31, 32 } == color_at(3));
+
+    expect(player.poll(view));
+    expect(rgb888{ 20, 21, 22 } == color_at(0));
+    expect(rgb888{ 40, 41, 42 } == color_at(1));
+    expect(rgb888{ 30, 31, 32 } == color_at(3));
+
+    expect(!player.poll(view));
+  };
+
+  "animation_player resumes across partial reads"_test = []() {
+    // Setup
+    auto animation = make_header(4, 2);
+    animation.insert(animation.end(), { 0x00, 1, 2, 3, 4, 5, 6, 7, 8 });
+    trickle_frame_source source(animation, 3);
+    animation_player player(source);
+    ws2812b_spi_frame<2, grbw_format> frame{};
+    ws2812b_spi_frame_view view(frame);
+
+    // Exercise
+    std::size_t polls = 1;
+    while (!player.poll(view)) {
+      polls++;
+    }
+
+    // Verify
+    // 19 bytes arrive 3 at a time with a starved read after each arrival
+    expect(that % 7U == polls);
+    expect(rgbw8888{ 1, 2, 3, 4 } == view.get(0));
+    expect(rgbw8888{ 5, 6, 7, 8 } == view.get(1));
+  };
+
+  "animation_player drops pixels beyond the frame"_test = []() {
+    // Setup
+    auto animation = make_header(3, 3);
+    animation.insert(animation.end(), { 0x01, 2, 9, 9, 9 });
+    memory_frame_source source(animation);
+    animation_player player(source);
+    ws2812b_spi_frame<2> frame{};
+
+    // Exercise
+    auto const complete = player.poll(ws2812b_spi_frame_view(frame));
+
+    // Verify
+    expect(complete);
+    expect(rgb888{ 9, 9, 9 } == ws2812b_spi_frame_view(frame).get(1));
+  };
+
+  "animation_player replays after rewind"_test = []() {
+    // Setup
+    auto animation = make_header(3, 1);
+    animation.insert(animation.end(), { 0x00, 7, 8, 9 });
+    memory_frame_source source(animation);
+    animation_player player(source);
+    apa102_frame<1> frame{};
+
+    // Exercise
+    expect(player.poll(apa102_frame_view(frame)));
+    expect(!player.poll(apa102_frame_view(frame)));
+    source.rewind();
+    player.reset();
+    frame.pixels[0].red = 0;
+
+    // Verify
+    expect(player.poll(apa102_frame_view(frame)));
+    expect(that % 7 == frame.pixels[0].red);
+  };
+
+  "animation_decoder rejects malformed animations"_test = []() {
+    auto bad_magic = make_header(3, 1);
+    bad_magic[0] = 'X';
+    auto bad_channels = make_header(5, 1);
+    auto bad_type = make_header(3, 1);
+    bad_type.push_back(0x07);
+
+    for (auto const* animation : { &bad_magic, &bad_channels, &bad_type }) {
+      expect(throws<hal::io_error>([animation]() {
+        animation_decoder decoder;
+        for (auto const byte : *animation) {
+          decoder.feed(byte);
+        }
+      }));
+    }
+  };
+
+  "animation_decoder keeps decoding after a rejected header"_test = []() {
+    // Setup
+    animation_decoder decoder;
+    auto bad_magic = make_header(3, 1);
+    bad_magic[0] = 'X';
+    auto animation = make_header(3, 1);
+    animation.insert(animation.end(), { 0x00, 7, 8, 9 });
+    std::size_t rejected = 0;
+
+    // Exercise
+    for (auto const byte : bad_magic) {
+      try {
+        decoder.feed(byte);
+      } catch (hal::io_error const&) {
+        rejected++;
+      }
+    }
+    animation_decoder::event last{};
+    for (auto const byte : animation) {
+      last = decoder.feed(byte);
+    }
+
+    // Verify
+    expect(that % 1U == rejected);
+    expect(decoder.has_header());
+    expect(last.frame_complete);
+    expect(rgbw8888{ 7, 8, 9, 0 } == last.color);
+  };
+};
+}  // namespace hal::display
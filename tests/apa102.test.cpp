@@ -13,3 +13,201 @@
 // limitations under the License.
 
 #include <libhal-display/apa102.hpp>
+
+#include <array>
+
+#include <libhal-util/mock/spi.hpp>
+
+#include <boost/ut.hpp>
+
+namespace hal::display {
+boost::ut::suite<"apa102_test"> apa102_test = [] {
+  using namespace boost::ut;
+
+  "apa102_frame_size()"_test = []() {
+    static_assert(0U == apa102_frame_size(0));
+    static_assert(4U == apa102_frame_size(1));
+    static_assert(sizeof(apa102_frame<60>) == apa102_frame_size(60));
+  };
+
+  "apa102_end_frame_size() covers one clock per two pixels"_test = []() {
+    static_assert(4U == apa102_end_frame_size(0));
+    static_assert(4U == apa102_end_frame_size(64));
+    static_assert(8U == apa102_end_frame_size(65));
+    static_assert(20U == apa102_end_frame_size(300));
+    static_assert(4U + 1200U + 20U == apa102_stream_size(300));
+  };
+
+  "apa102_frame_view(buffer, count)"_test = []() {
+    // Setup
+    std::array<apa102_pixel, 8> arena{};
+
+    // Exercise
+    apa102_frame_view view(arena, 5);
+
+    // Verify
+    expect(that % 5U == view.pixel_count());
+    expect(that % arena.data() == view.pixels().data());
+  };
+
+  "apa102_frame_view(buffer, count) rejects small buffer"_test = []() {
+    std::array<apa102_pixel, 4> arena{};
+
+    expect(throws<hal::argument_out_of_domain>(
+      [&arena]() { apa102_frame_view(arena, 5); }));
+  };
+
+  "apa102::update(apa102_frame_view)"_test = []() {
+    // Setup
+    hal::mock_write_only_spi spi;
+    apa102 test_subject(spi);
+    std::array<apa102_pixel, 8> arena{};
+    arena[0] = { .brightness = 0xE1, .blue = 1, .green = 2, .red = 3 };
+    arena[1] = { .brightness = 0xE2, .blue = 4, .green = 5, .red = 6 };
+    std::vector<hal::byte> const expected = { 0xE1, 1, 2, 3, 0xE2, 4, 5, 6 };
+
+    // Exercise
+    test_subject.update(apa102_frame_view(arena, 2));
+
+    // Verify
+    expect(that % 3U == spi.write_record.size());
+    expect(std::vector<hal::byte>{ 0x00, 0x00, 0x00, 0x00 } ==
+           spi.write_record[0]);
+    expect(expected == spi.write_record[1]);
+    expect(std::vector<hal::byte>{ 0xFF, 0xFF, 0xFF, 0xFF } ==
+           spi.write_record[2]);
+  };
+
+  "apa102::update(apa102_frame) matches view"_test = []() {
+    // Setup
+    hal::mock_write_only_spi spi;
+    apa102 test_subject(spi);
+    apa102_frame<2> frame{};
+    frame.pixels[1].red = 0x42;
+
+    // Exercise
+    test_subject.update(frame);
+
+    // Verify
+    expect(that % 3U == spi.write_record.size());
+    expect(that % 8U == spi.write_record[1].size());
+    expect(that % 0x42 == spi.write_record[1][7]);
+  };
+
+  "kelvin_to_rgb(span<uint16_t>, apa102_frame_view)"_test = []() {
+    // Setup
+    apa102_frame<2> frame{};
+    frame.pixels[0].brightness = 0xE3;
+    std::array<std::uint16_t, 2> const temperatures = { 2700, 6500 };
+    auto const warm = kelvin_to_rgb(2700);
+
+    // Exercise
+    kelvin_to_rgb(temperatures, frame);
+
+    // Verify
+    expect(that % 0xE3 == frame.pixels[0].brightness);
+    expect(that % warm.red == frame.pixels[0].red);
+    expect(that % warm.green == frame.pixels[0].green);
+    expect(that % warm.blue == frame.pixels[0].blue);
+  };
+
+  "make_apa102_stream() builds a complete transmission"_test = []() {
+    // Setup
+    static constexpr auto stream = make_apa102_stream(
+      std::array<rgb888, 2>{ { { 3, 2, 1 }, { 6, 5, 4 } } }, 0b0'0101);
+    static_assert(apa102_stream_size(2) == stream.size());
+    std::vector<hal::byte> const expected = {
+      0x00, 0x00, 0x00, 0x00,  // start frame
+      0xE5, 1,    2,    3,     // pixel 0
+      0xE5, 4,    5,    6,     // pixel 1
+      0xFF, 0xFF, 0xFF, 0xFF,  // end frame
+    };
+    hal::mock_write_only_spi spi;
+    apa102 test_subject(spi);
+
+    // Exercise
+    test_subject.update(stream);
+
+    // Verify
+    expect(that % 1U == spi.write_record.size());
+    expect(expected == spi.write_record[0]);
+  };
+
+  "apa102 end frames grow with long strips"_test = []() {
+    // Setup
+    static constexpr auto stream =
+      make_apa102_stream(std::array<rgb888, 100>{});
+    hal::mock_write_only_spi spi;
+    apa102 test_subject(spi);
+    apa102_frame<100> frame{};
+
+    // Exercise
+    test_subject.update(frame);
+
+    // Verify
+    // 100 pixels need 50 clocks, or two words of 0xFF
+    expect(std::vector<hal::byte>(8, 0xFF) ==
+           std::vector<hal::byte>(stream.end() - 8, stream.end()));
+    // Red of the last pixel
+    expect(that % 0x00 == stream[stream.size() - 9]);
+    expect(that % 4U == spi.write_record.size());
+    expect(std::vector<hal::byte>(4, 0xFF) == spi.write_record[2]);
+    expect(std::vector<hal::byte>(4, 0xFF) == spi.write_record[3]);
+  };
+
+  "apa102_frame_view fill helpers keep brightness"_test = []() {
+    // Setup
+    apa102_frame<5> frame{};
+    apa102_frame_view view(frame);
+    frame.pixels[1].brightness = 0xE7;
+
+    // Exercise
+    view.fill({ 9, 8, 7 });
+    auto const filled = frame.pixels;
+    view.gradient(0, 5, { 0, 0, 0 }, { 255, 128, 4 });
+    auto const graded = frame.pixels;
+    view.clear();
+
+    // Verify
+    expect(that % 9U == filled[4].red);
+    expect(that % 8U == filled[4].green);
+    expect(that % 7U == filled[4].blue);
+    expect(that % 0U == graded[0].red);
+    expect(that % 128U == graded[2].red);
+    expect(that % 64U == graded[2].green);
+    expect(that % 2U == graded[2].blue);
+    expect(that % 255U == graded[4].red);
+    expect(that % 0U == frame.pixels[4].red);
+    expect(that % 0xE7 == frame.pixels[1].brightness);
+    expect(that % 0xFF == frame.pixels[0].brightness);
+  };
+
+  "apa102_frame_view fill helpers update a power meter"_test = []() {
+    // Setup
+    apa102_frame<6> frame{};
+    frame.pixels[2].brightness = 0b1110'0000 | 7;
+    power_meter meter({ .budget_milliamps = 500 });
+    apa102_frame_view view(frame, meter);
+    auto const recount = [&frame]() {
+      power_meter expected({ .budget_milliamps = 500 });
+      for (auto const& pixel : frame.pixels) {
+        expected.exchange(
+          0,
+          power_meter::load(rgb888{ pixel.red, pixel.green, pixel.blue },
+                            pixel.brightness & 0b1'1111));
+      }
+      return expected.milliamps(frame.pixels.size());
+    };
+
+    // Exercise & Verify
+    view.fill({ 255, 255, 255 });
+    expect(that % recount() == meter.milliamps(6));
+    view.fill(1, 3, { 10, 0, 0 });
+    expect(that % recount() == meter.milliamps(6));
+    view.gradient(0, 4, { 0, 0, 0 }, { 0, 200, 100 });
+    expect(that % recount() == meter.milliamps(6));
+    view.clear();
+    expect(that % 6U == meter.milliamps(6));
+  };
+};
+}  // namespace hal::display
@@ -0,0 +1,224 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <libhal-display/color.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+#include <boost/ut.hpp>
+
+namespace hal::display {
+namespace {
+struct float_rgb
+{
+  float red;
+  float green;
+  float blue;
+};
+
+float_rgb reference_hsv(hsv p_color)
+{
+  float const hue = (p_color.hue / 65536.0f) * 6.0f;
+  float const saturation = p_color.saturation / 255.0f;
+  float const value = p_color.value;
+  float const chroma = value * saturation;
+  float const secondary =
+    chroma * (1.0f - std::fabs(std::fmod(hue, 2.0f) - 1.0f));
+  float const minimum = value - chroma;
+  switch (static_cast<int>(hue)) {
+    case 0:
+      return { value, minimum + secondary, minimum };
+    case 1:
+      return { minimum + secondary, value, minimum };
+    case 2:
+      return { minimum, value, minimum + secondary };
+    case 3:
+      return { minimum, minimum + secondary, value };
+    case 4:
+      return { minimum + secondary, minimum, value };
+    default:
+      return { value, minimum, minimum + secondary };
+  }
+}
+
+float_rgb reference_hsl(hsl p_color)
+{
+  float const hue = (p_color.hue / 65536.0f) * 6.0f;
+  float const saturation = p_color.saturation / 255.0f;
+  float const lightness = p_color.lightness / 255.0f;
+  float const chroma =
+    (1.0f - std::fabs(2.0f * lightness - 1.0f)) * saturation * 255.0f;
+  float const secondary =
+    chroma * (1.0f - std::fabs(std::fmod(hue, 2.0f) - 1.0f));
+  float const minimum = p_color.lightness - chroma / 2.0f;
+  switch (static_cast<int>(hue)) {
+    case 0:
+      return { minimum + chroma, minimum + secondary, minimum };
+    case 1:
+      return { minimum + secondary, minimum + chroma, minimum };
+    case 2:
+      return { minimum, minimum + chroma, minimum + secondary };
+    case 3:
+      return { minimum, minimum + secondary, minimum + chroma };
+    case 4:
+      return { minimum + secondary, minimum, minimum + chroma };
+    default:
+      return { minimum + chroma, minimum, minimum + secondary };
+  }
+}
+
+// Tanner Helland's curve fit of the black body color temperature
+float_rgb reference_kelvin(float p_kelvin)
+{
+  auto const clamp = [](float p_value) {
+    return std::clamp(p_value, 0.0f, 255.0f);
+  };
+  float const temperature = p_kelvin / 100.0f;
+  float_rgb result{};
+
+  if (temperature <= 66.0f) {
+    result.red = 255.0f;
+    result.green = 99.4708025861f * std::log(temperature) - 161.1195681661f;
+  } else {
+    result.red = 329.698727446f * std::pow(temperature - 60.0f, -0.1332047592f);
+    result.green =
+      288.1221695283f * std::pow(temperature - 60.0f, -0.0755148492f);
+  }
+
+  if (temperature >= 66.0f) {
+    result.blue = 255.0f;
+  } else if (temperature <= 19.0f) {
+    result.blue = 0.0f;
+  } else {
+    result.blue =
+      138.5177312231f * std::log(temperature - 10.0f) - 305.0447927307f;
+  }
+
+  return { clamp(result.red), clamp(result.green), clamp(result.blue) };
+}
+
+float max_error(rgb888 p_actual, float_rgb p_expected)
+{
+  return std::max({ std::fabs(p_actual.red - p_expected.red),
+                    std::fabs(p_actual.green - p_expected.green),
+                    std::fabs(p_actual.blue - p_expected.blue) });
+}
+}  // namespace
+
+boost::ut::suite<"color_test"> color_test = [] {
+  using namespace boost::ut;
+
+  "scale_channel()"_test = []() {
+    for (unsigned channel = 0; channel < 256; channel++) {
+      for (unsigned factor = 0; factor < 256; factor++) {
+        auto const expected = std::lround(channel * factor / 255.0);
+        auto const actual = scale_channel(static_cast<hal::byte>(channel),
+                                          static_cast<hal::byte>(factor));
+        expect(that % expected == actual);
+      }
+    }
+  };
+
+  "mix_channel()"_test = []() {
+    for (unsigned from = 0; from < 256; from += 5) {
+      for (unsigned to = 0; to < 256; to += 3) {
+        for (unsigned amount = 0; amount < 256; amount++) {
+          auto const expected =
+            std::lround((from * (255 - amount) + to * amount) / 255.0);
+          auto const actual = mix_channel(static_cast<hal::byte>(from),
+                                          static_cast<hal::byte>(to),
+                                          static_cast<hal::byte>(amount));
+          expect(that % expected == actual);
+        }
+      }
+    }
+  };
+
+  "gradient_amount() spans the full range"_test = []() {
+    static_assert(0U == gradient_amount(0, 1));
+    static_assert(0U == gradient_amount(0, 5));
+    static_assert(128U == gradient_amount(2, 5));
+    static_assert(255U == gradient_amount(4, 5));
+  };
+
+  "to_rgb(hsv) primaries"_test = []() {
+    expect(rgb888{ 255, 0, 0 } == to_rgb(hsv{ 0, 255, 255 }));
+    expect(rgb888{ 0, 255, 0 } == to_rgb(hsv{ 21845, 255, 255 }));
+    expect(rgb888{ 0, 0, 255 } == to_rgb(hsv{ 43690, 255, 255 }));
+    expect(rgb888{ 90, 90, 90 } == to_rgb(hsv{ 12345, 0, 90 }));
+  };
+
+  "to_rgb(hsv) matches float reference"_test = []() {
+    float worst = 0.0f;
+    for (unsigned hue = 0; hue < 65536; hue += 97) {
+      for (unsigned saturation = 0; saturation < 256; saturation += 15) {
+        for (unsigned value = 0; value < 256; value += 15) {
+          hsv const color{ static_cast<std::uint16_t>(hue),
+                           static_cast<hal::byte>(saturation),
+                           static_cast<hal::byte>(value) };
+          worst =
+            std::max(worst, max_error(to_rgb(color), reference_hsv(color)));
+        }
+      }
+    }
+    expect(worst <= 2.0f) << "worst error:" << worst;
+  };
+
+  "to_rgb(hsl) primaries"_test = []() {
+    // Lightness of 128 is 0.502, so the other channels sit just above 0
+    expect(rgb888{ 255, 1, 1 } == to_rgb(hsl{ 0, 255, 128 }));
+    expect(rgb888{ 255, 255, 255 } == to_rgb(hsl{ 0, 255, 255 }));
+    expect(rgb888{ 0, 0, 0 } == to_rgb(hsl{ 43690, 255, 0 }));
+    expect(rgb888{ 90, 90, 90 } == to_rgb(hsl{ 12345, 0, 90 }));
+  };
+
+  "to_rgb(hsl) matches float reference"_test = []() {
+    float worst = 0.0f;
+    for (unsigned hue = 0; hue < 65536; hue += 97) {
+      for (unsigned saturation = 0; saturation < 256; saturation += 15) {
+        for (unsigned lightness = 0; lightness < 256; lightness += 15) {
+          hsl const color{ static_cast<std::uint16_t>(hue),
+                           static_cast<hal::byte>(saturation),
+                           static_cast<hal::byte>(lightness) };
+          worst =
+            std::max(worst, max_error(to_rgb(color), reference_hsl(color)));
+        }
+      }
+    }
+    expect(worst <= 2.0f) << "worst error:" << worst;
+  };
+
+  "kelvin_to_rgb() matches float reference"_test = []() {
+    float worst = 0.0f;
+    for (unsigned kelvin = 1000; kelvin <= 40000; kelvin += 7) {
+      // Helland's fit is discontinuous at 6600K, skip the step itself
+      if (kelvin > 6600 && kelvin < 6700) {
+        continue;
+      }
+      auto const actual = kelvin_to_rgb(static_cast<std::uint16_t>(kelvin));
+      worst = std::max(
+        worst, max_error(actual, reference_kelvin(static_cast<float>(kelvin))));
+    }
+    expect(worst <= 3.0f) << "worst error:" << worst;
+  };
+
+  "kelvin_to_rgb() clamps out of range temperatures"_test = []() {
+    expect(kelvin_to_rgb(1000) == kelvin_to_rgb(0));
+    expect(kelvin_to_rgb(40000) == kelvin_to_rgb(65535));
+    expect(rgb888{ 255, 255, 255 } == kelvin_to_rgb(6600));
+  };
+};
+}  // namespace hal::display
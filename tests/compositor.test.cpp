@@ -0,0 +1,263 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <libhal-display/compositor.hpp>
+
+#include <algorithm>
+#include <array>
+
+#include <libhal-display/apa102.hpp>
+#include <libhal-display/ws2812b.hpp>
+
+#include <boost/ut.hpp>
+
+namespace hal::display {
+namespace {
+rgb888 color_at(apa102_frame_view p_frame, std::size_t p_index)
+{
+  auto const& pixel = p_frame.pixels()[p_index];
+  return { pixel.red, pixel.green, pixel.blue };
+}
+}  // namespace
+
+boost::ut::suite<"compositor_test"> compositor_test = [] {
+  using namespace boost::ut;
+
+  "blend kernels match per channel arithmetic"_test = []() {
+    // Walk a spread of channel pairs through every lane at once
+    for (unsigned a = 0; a < 256; a += 3) {
+      for (unsigned b = 0; b < 256; b += 5) {
+        for (unsigned weight : { 0U, 1U, 64U, 129U, 255U, 256U }) {
+          auto const destination = pack({ static_cast<hal::byte>(a),
+                                          static_cast<hal::byte>(b),
+                                          static_cast<hal::byte>(255 - a) });
+          auto const source = pack({ static_cast<hal::byte>(b),
+                                     static_cast<hal::byte>(a),
+                                     static_cast<hal::byte>(255 - b) });
+          auto const dst = unpack(destination);
+          auto const src = unpack(source);
+          auto const scaled = [weight](unsigned p_value) {
+            return (p_value * weight) >> 8U;
+          };
+          auto const reference = [&](auto p_function) {
+            return rgb888{
+              static_cast<hal::byte>(p_function(dst.red, src.red)),
+              static_cast<hal::byte>(p_function(dst.green, src.green)),
+              static_cast<hal::byte>(p_function(dst.blue, src.blue)),
+            };
+          };
+
+          auto const normal = reference([weight](unsigned d, unsigned s) {
+            return (d * (256U - weight) + s * weight) >> 8U;
+          });
+          auto const additive = reference([&](unsigned d, unsigned s) {
+            return std::min(255U, d + scaled(s));
+          });
+          auto const maximum = reference(
+            [&](unsigned d, unsigned s) { return std::max(d, scaled(s)); });
+
+          expect(normal ==
+                 unpack(blend_normal(destination, source, weight)));
+          expect(additive ==
+                 unpack(blend_additive(destination, source, weight)));
+          expect(maximum ==
+                 unpack(blend_maximum(destination, source, weight)));
+        }
+      }
+    }
+  };
+
+  "compositor blends layers in order"_test = []() {
+    // Setup
+    std::array<rgba8888, 3> const background = { {
+      { 100, 100, 100, 255 },
+      { 100, 100, 100, 255 },
+      { 100, 100, 100, 255 },
+    } };
+    std::array<rgba8888, 2> const overlay = { {
+      { 200, 0, 0, 255 },
+      { 200, 0, 0, 0 },
+    } };
+    std::array<rgba8888, 3> const flash = { {
+      { 0, 0, 200, 255 },
+      { 0, 0, 200, 255 },
+      { 0, 0, 200, 255 },
+    } };
+    std::array<layer, 3> const layers = { {
+      { .pixels = background },
+      { .pixels = overlay, .mode = blend_mode::normal },
+      { .pixels = flash, .mode = blend_mode::additive },
+    } };
+    apa102_frame<4> frame{};
+    frame.pixels[3].red = 77;
+    compositor test_subject;
+
+    // Exercise
+    auto const written =
+      test_subject.composite(layers, apa102_frame_view(frame));
+
+    // Verify
+    expect(written);
+    expect(rgb888{ 200, 0, 200 } == color_at(frame, 0));
+    expect(rgb888{ 100, 100, 255 } == color_at(frame, 1));
+    expect(rgb888{ 100, 100, 255 } == color_at(frame, 2));
+    // Pixels no layer covers end up black
+    expect(rgb888{ 0, 0, 0 } == color_at(frame, 3));
+  };
+
+  "compositor applies layer opacity and skips empty layers"_test = []() {
+    // Setup
+    std::array<rgba8888, 1> const white = { { { 255, 255, 255, 255 } } };
+    std::array<rgba8888, 1> const red = { { { 255, 0, 0, 255 } } };
+    std::array<layer, 2> layers = { {
+      { .pixels = white, .opacity = 128 },
+      { .pixels = red, .is_empty = true },
+    } };
+    ws2812b_spi_frame<1> frame{};
+    compositor test_subject;
+
+    // Exercise
+    test_subject.composite(layers, ws2812b_spi_frame_view(frame));
+
+    // Verify
+    expect(rgb888{ 128, 128, 128 } == ws2812b_spi_frame_view(frame).get(0));
+  };
+
+  "compositor skips work when every layer is static"_test = []() {
+    // Setup
+    std::array<rgba8888, 1> const white = { { { 255, 255, 255, 255 } } };
+    std::array<layer, 1> layers = { {
+      { .pixels = white, .is_static = true },
+    } };
+    apa102_frame<1> frame{};
+    compositor test_subject;
+
+    // Exercise & Verify
+    expect(test_subject.composite(layers, apa102_frame_view(frame)));
+    expect(!test_subject.composite(layers, apa102_frame_view(frame)));
+    test_subject.invalidate();
+    expect(test_subject.composite(layers, apa102_frame_view(frame)));
+    layers[0].is_static = false;
+    expect(test_subject.composite(layers, apa102_frame_view(frame)));
+  };
+
+  "compositor only skips the frame it last wrote"_test = []() {
+    // Setup
+    std::array<rgba8888, 1> const white = { { { 255, 255, 255, 255 } } };
+    std::array<layer, 1> const layers = { {
+      { .pixels = white, .is_static = true },
+    } };
+    std::array<apa102_frame<1>, 2> frames{};
+    compositor test_subject;
+
+    // Exercise & Verify
+    expect(test_subject.composite(layers, apa102_frame_view(frames[0])));
+    expect(test_subject.composite(layers, apa102_frame_view(frames[1])));
+    expect(rgb888{ 255, 255, 255 } == color_at(frames[1], 0));
+    expect(!test_subject.composite(layers, apa102_frame_view(frames[1])));
+  };
+
+  "compositor removes a layer once it is empty"_test = []() {
+    // Setup
+    std::array<rgba8888, 1> const background = { { { 0, 0, 50, 255 } } };
+    std::array<rgba8888, 1> const notification = { { { 0, 200, 0, 255 } } };
+    std::array<layer, 2> layers = { {
+      { .pixels = background, .is_static = true },
+      { .pixels = notification },
+    } };
+    apa102_frame<1> frame{};
+    compositor test_subject;
+
+    // Exercise & Verify
+    expect(test_subject.composite(layers, apa102_frame_view(frame)));
+    expect(rgb888{ 0, 200, 0 } == color_at(frame, 0));
+    layers[1].is_empty = true;
+    expect(test_subject.composite(layers, apa102_frame_view(frame)));
+    expect(rgb888{ 0, 0, 50 } == color_at(frame, 0));
+    expect(!test_subject.composite(layers, apa102_frame_view(frame)));
+  };
+
+  "compositor removes a layer once it fades out"_test = []() {
+    // Setup
+    std::array<rgba8888, 1> const background = { { { 0, 0, 50, 255 } } };
+    std::array<rgba8888, 1> const notification = { { { 0, 200, 0, 255 } } };
+    std::array<layer, 2> layers = { {
+      { .pixels = background, .is_static = true },
+      { .pixels = notification, .is_static = true },
+    } };
+    std::array<std::uint32_t, 1> cache{};
+    apa102_frame<1> frame{};
+    compositor test_subject(cache);
+
+    // Exercise & Verify
+    expect(test_subject.composite(layers, apa102_frame_view(frame)));
+    expect(!test_subject.composite(layers, apa102_frame_view(frame)));
+    layers[1].opacity = 128;
+    expect(test_subject.composite(layers, apa102_frame_view(frame)));
+    expect(rgb888{ 0, 100, 24 } == color_at(frame, 0));
+    layers[1].opacity = 0;
+    expect(test_subject.composite(layers, apa102_frame_view(frame)));
+    expect(rgb888{ 0, 0, 50 } == color_at(frame, 0));
+    expect(!test_subject.composite(layers, apa102_frame_view(frame)));
+  };
+
+  "compositor caches static layers beneath moving layers"_test = []() {
+    // Setup
+    std::array<rgba8888, 2> background = { {
+      { 0, 0, 200, 255 },
+      { 0, 200, 0, 255 },
+    } };
+    std::array<rgba8888, 1> overlay = { { { 255, 0, 0, 128 } } };
+    std::array<layer, 2> const layers = { {
+      { .pixels = background, .is_static = true },
+      { .pixels = overlay },
+    } };
+    std::array<std::uint32_t, 2> cache{};
+    apa102_frame<2> frame{};
+    compositor test_subject(cache);
+
+    // Exercise
+    test_subject.composite(layers, apa102_frame_view(frame));
+    auto const first = color_at(frame, 0);
+    // A static layer is promised not to change, so changing it anyway shows
+    // whether it was blended again
+    background[0] = { 0, 0, 0, 255 };
+    overlay[0].red = 0;
+    test_subject.composite(layers, apa102_frame_view(frame));
+    auto const cached = color_at(frame, 0);
+    test_subject.invalidate();
+    test_subject.composite(layers, apa102_frame_view(frame));
+
+    // Verify
+    expect(rgb888{ 128, 0, 99 } == first);
+    expect(rgb888{ 0, 0, 99 } == cached);
+    expect(rgb888{ 0, 200, 0 } == color_at(frame, 1));
+    expect(rgb888{ 0, 0, 0 } == color_at(frame, 0));
+  };
+
+  "compositor rejects more layers than it can hold"_test = []() {
+    std::array<rgba8888, 1> const white = { { { 255, 255, 255, 255 } } };
+    std::array<layer, 3> const layers = { {
+      { .pixels = white },
+      { .pixels = white, .is_empty = true },
+      { .pixels = white },
+    } };
+    apa102_frame<1> frame{};
+    compositor<1> test_subject;
+
+    expect(throws<hal::argument_out_of_domain>(
+      [&]() { test_subject.composite(layers, apa102_frame_view(frame)); }));
+  };
+};
+}  // namespace hal::display
@@ -0,0 +1,87 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <libhal-display/frame_source.hpp>
+
+#include <array>
+#include <vector>
+
+#include <boost/ut.hpp>
+
+namespace hal::display {
+boost::ut::suite<"frame_source_test"> frame_source_test = [] {
+  using namespace boost::ut;
+
+  "memory_frame_source reads in order and rewinds"_test = []() {
+    // Setup
+    std::array<hal::byte, 5> const stream = { 1, 2, 3, 4, 5 };
+    memory_frame_source source(stream);
+    std::array<hal::byte, 3> buffer{};
+
+    // Exercise & Verify
+    expect(that % 3U == source.read(buffer).size());
+    auto const rest = source.read(buffer);
+    expect(std::vector<hal::byte>{ 4, 5 } ==
+           std::vector<hal::byte>(rest.begin(), rest.end()));
+    expect(source.read(buffer).empty());
+    source.rewind();
+    expect(that % 1 == source.read(buffer)[0]);
+  };
+
+  "byte_pump resumes within a chunk after stopping"_test = []() {
+    // Setup
+    std::vector<hal::byte> stream(byte_pump::chunk_size + 10);
+    for (std::size_t i = 0; i < stream.size(); i++) {
+      stream[i] = static_cast<hal::byte>(i);
+    }
+    memory_frame_source source(stream);
+    byte_pump pump;
+    std::vector<hal::byte> consumed;
+    auto const until = [&consumed](hal::byte p_last) {
+      return [&consumed, p_last](hal::byte p_byte) {
+        consumed.push_back(p_byte);
+        return p_byte == p_last;
+      };
+    };
+
+    // Exercise & Verify
+    expect(pump.drain(source, until(5)));
+    expect(that % byte_pump::chunk_size == pump.bytes_read());
+    expect(pump.drain(source, until(byte_pump::chunk_size + 2)));
+    expect(!pump.drain(source, until(0xFF)));
+    expect(stream == consumed);
+    expect(that % stream.size() == pump.bytes_read());
+  };
+
+  "byte_pump::discard() drops unconsumed bytes"_test = []() {
+    // Setup
+    std::array<hal::byte, 4> const stream = { 1, 2, 3, 4 };
+    memory_frame_source source(stream);
+    byte_pump pump;
+    hal::byte last = 0;
+
+    // Exercise
+    pump.drain(source, [](hal::byte) { return true; });
+    pump.discard();
+    source.rewind();
+    pump.drain(source, [&last](hal::byte p_byte) {
+      last = p_byte;
+      return true;
+    });
+
+    // Verify
+    expect(that % 1 == last);
+  };
+};
+}  // namespace hal::display
@@ -0,0 +1,89 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <libhal-display/hd108.hpp>
+
+#include <array>
+#include <vector>
+
+#include <libhal-util/mock/spi.hpp>
+
+#include <boost/ut.hpp>
+
+namespace hal::display {
+boost::ut::suite<"hd108_test"> hd108_test = [] {
+  using namespace boost::ut;
+
+  "hd108_frame_size()"_test = []() {
+    static_assert(0U == hd108_frame_size(0));
+    static_assert(8U == hd108_frame_size(1));
+    static_assert(sizeof(hd108_frame<60>) == hd108_frame_size(60));
+  };
+
+  "hd108_frame_view::set() stores 16-bit channels MSB first"_test = []() {
+    // Setup
+    hd108_frame<2> frame{};
+    hd108_frame_view view(frame);
+    rgb161616 const color{ .red = 0x1234, .green = 0x5678, .blue = 0x9ABC };
+
+    // Exercise
+    view.set(0, color);
+    view.set(1, rgb888{ .red = 255, .green = 1, .blue = 0 });
+
+    // Verify
+    expect(color == view.get(0));
+    expect(that % 0x12 == frame.pixels[0].red_high);
+    expect(that % 0xBC == frame.pixels[0].blue_low);
+    expect(rgb161616{ 0xFFFF, 0x0101, 0 } == view.get(1));
+    // Gain is left at full current
+    expect(that % 0xFF == frame.pixels[0].header_high);
+    expect(that % 0xFF == frame.pixels[0].header_low);
+  };
+
+  "hd108_frame_view::set_gain() packs a 5-bit gain per channel"_test = []() {
+    // Setup
+    hd108_frame<1> frame{};
+
+    // Exercise
+    hd108_frame_view(frame).set_gain(0, 0b10101, 0b01110, 0b00011);
+
+    // Verify
+    // 1 10101 01110 00011
+    expect(that % 0b1101'0101 == frame.pixels[0].header_high);
+    expect(that % 0b1100'0011 == frame.pixels[0].header_low);
+  };
+
+  "hd108::update(hd108_frame)"_test = []() {
+    // Setup
+    hal::mock_write_only_spi spi;
+    hd108 test_subject(spi);
+    hd108_frame<100> frame{};
+    hd108_frame_view(frame).fill({ .red = 0x0102 });
+
+    // Exercise
+    test_subject.update(frame);
+
+    // Verify
+    // Start frame, pixels, then one end frame byte for every 16 pixels,
+    // sent in words of 4 bytes
+    expect(that % 4U == spi.write_record.size());
+    expect(std::vector<hal::byte>(16, 0x00) == spi.write_record[0]);
+    expect(that % hd108_frame_size(100) == spi.write_record[1].size());
+    expect(that % 0x01 == spi.write_record[1][2]);
+    expect(that % 0x02 == spi.write_record[1][3]);
+    expect(std::vector<hal::byte>(4, 0xFF) == spi.write_record[2]);
+    expect(std::vector<hal::byte>(4, 0xFF) == spi.write_record[3]);
+  };
+};
+}  // namespace hal::display
@@ -0,0 +1,180 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <libhal-display/planar.hpp>
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+#include <libhal-display/apa102.hpp>
+#include <libhal-display/ws2812b.hpp>
+#include <libhal-util/mock/spi.hpp>
+
+#include <boost/ut.hpp>
+
+namespace hal::display {
+namespace {
+std::vector<hal::byte> concatenate(
+  std::vector<std::vector<hal::byte>> const& p_writes)
+{
+  std::vector<hal::byte> result;
+  for (auto const& write : p_writes) {
+    result.insert(result.end(), write.begin(), write.end());
+  }
+  return result;
+}
+}  // namespace
+
+boost::ut::suite<"planar_test"> planar_test = [] {
+  using namespace boost::ut;
+
+  "planar_frame_size()"_test = []() {
+    static_assert(0U == planar_frame_size(0));
+    static_assert(180U == planar_frame_size(60));
+    static_assert(sizeof(planar_frame<60>) == planar_frame_size(60));
+    static_assert(sizeof(planar_frame<60, true>) ==
+                  planar_frame_size(60, true));
+    static_assert(sizeof(planar_frame<60, true, true>) ==
+                  planar_frame_size(60, true, true));
+  };
+
+  "plane operations"_test = []() {
+    // Setup
+    std::array<hal::byte, 4> plane = { 0, 100, 200, 255 };
+    std::array<hal::byte, 4> const target = { 255, 255, 0, 0 };
+
+    // Exercise
+    auto scaled = plane;
+    scale_plane(scaled, 128);
+    auto added = plane;
+    add_plane(added, 100);
+    auto subtracted = plane;
+    subtract_plane(subtracted, 150);
+    auto mixed = plane;
+    mix_plane(mixed, target, 255);
+
+    // Verify
+    expect(std::array<hal::byte, 4>{ 0, 50, 100, 128 } == scaled);
+    expect(std::array<hal::byte, 4>{ 100, 200, 255, 255 } == added);
+    expect(std::array<hal::byte, 4>{ 0, 0, 50, 105 } == subtracted);
+    expect(target == mixed);
+  };
+
+  "planar_frame_view sets and gets pixels through the planes"_test = []() {
+    // Setup
+    planar_frame<3, true> frame{};
+    planar_frame_view view(frame);
+
+    // Exercise
+    view.fill({ 1, 2, 3 });
+    view.set_rgbw(1, { 4, 5, 6, 7 });
+    view.red()[2] = 9;
+
+    // Verify
+    expect(that % 3U == view.pixel_count());
+    expect(that % 0U == view.brightness().size());
+    expect(rgb888{ 1, 2, 3 } == view.get(0));
+    expect(rgbw8888{ 4, 5, 6, 7 } == view.get_rgbw(1));
+    expect(rgb888{ 9, 2, 3 } == view.get(2));
+    expect(std::array<hal::byte, 3>{ 1, 4, 9 } == frame.red);
+  };
+
+  "planar_frame_view(planes) rejects small planes"_test = []() {
+    std::array<hal::byte, 4> large{};
+    std::array<hal::byte, 3> small{};
+
+    expect(nothrow([&]() { planar_frame_view(large, large, large, {}); }));
+    expect(throws<hal::argument_out_of_domain>(
+      [&]() { planar_frame_view(large, small, large); }));
+    expect(throws<hal::argument_out_of_domain>(
+      [&]() { planar_frame_view(large, large, large, small); }));
+    expect(throws<hal::argument_out_of_domain>(
+      [&]() { planar_frame_view(large, large, large, {}, small); }));
+  };
+
+  "apa102::update(planar_frame_view) interleaves the planes"_test = []() {
+    // Setup
+    hal::mock_write_only_spi spi;
+    apa102 test_subject(spi);
+    planar_frame<20, false, true> frame{};
+    planar_frame_view view(frame);
+    for (std::size_t i = 0; i < view.pixel_count(); i++) {
+      auto const value = static_cast<hal::byte>(i);
+      view.set(i, { value, static_cast<hal::byte>(value + 1), 0x42 });
+      frame.brightness[i] = value;
+    }
+
+    // Exercise
+    test_subject.update(frame);
+
+    // Verify
+    auto const sent = concatenate(spi.write_record);
+    expect(that % apa102_stream_size(20) == sent.size());
+    expect(std::vector<hal::byte>{ 0xE0, 0x42, 1, 0 } ==
+           std::vector<hal::byte>(sent.begin() + 4, sent.begin() + 8));
+    expect(std::vector<hal::byte>{ 0xF3, 0x42, 20, 19 } ==
+           std::vector<hal::byte>(sent.end() - 8, sent.end() - 4));
+  };
+
+  "planar_frame brightness starts at full brightness"_test = []() {
+    // Setup
+    hal::mock_write_only_spi spi;
+    apa102 test_subject(spi);
+    planar_frame<3, false, true> frame{};
+    planar_frame_view(frame).fill({ 1, 2, 3 });
+
+    // Exercise
+    test_subject.update(frame);
+
+    // Verify
+    expect(std::ranges::all_of(
+      frame.brightness, [](hal::byte p_value) { return p_value == 31; }));
+    auto const sent = concatenate(spi.write_record);
+    expect(std::vector<hal::byte>{ 0xFF, 3, 2, 1 } ==
+           std::vector<hal::byte>(sent.begin() + 4, sent.begin() + 8));
+  };
+
+  "ws2812b::update(planar_frame_view) matches an encoded frame"_test = []() {
+    // Setup
+    hal::mock_write_only_spi spi;
+    ws2812b test_subject(spi);
+    planar_frame<11, true> frame{};
+    planar_frame_view view(frame);
+    ws2812b_spi_frame<11> expected{};
+    ws2812b_spi_frame<11, grbw_format> expected_rgbw{};
+    for (std::size_t i = 0; i < view.pixel_count(); i++) {
+      auto const value = static_cast<hal::byte>(i * 23);
+      rgbw8888 const color{ value,
+                            static_cast<hal::byte>(~value),
+                            static_cast<hal::byte>(value ^ 0x5A),
+                            static_cast<hal::byte>(i) };
+      view.set_rgbw(i, color);
+      ws2812b_spi_frame_view(expected).set(i, view.get(i));
+      ws2812b_spi_frame_view(expected_rgbw).set(i, color);
+    }
+
+    // Exercise
+    test_subject.update(frame);
+    auto const sent = concatenate(spi.write_record);
+    spi.write_record.clear();
+    test_subject.update<grbw_format>(frame);
+    auto const sent_rgbw = concatenate(spi.write_record);
+
+    // Verify
+    expect(std::ranges::equal(expected.data, sent));
+    expect(std::ranges::equal(expected_rgbw.data, sent_rgbw));
+  };
+};
+}  // namespace hal::display
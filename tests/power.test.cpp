@@ -0,0 +1,217 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <libhal-display/power.hpp>
+
+#include <libhal-display/apa102.hpp>
+#include <libhal-display/compositor.hpp>
+#include <libhal-display/ws2812b.hpp>
+#include <libhal-util/mock/spi.hpp>
+
+#include <boost/ut.hpp>
+
+namespace hal::display {
+boost::ut::suite<"power_test"> power_test = [] {
+  using namespace boost::ut;
+
+  constexpr power_model model{
+    .milliamps_per_channel = 20,
+    .idle_milliamps_per_pixel = 1,
+    .budget_milliamps = 500,
+  };
+  constexpr rgb888 white{ 255, 255, 255 };
+
+  "power_meter tracks pixels as they are written"_test = [&]() {
+    // Setup
+    power_meter meter(model);
+    apa102_frame<10> frame{};
+    apa102_frame_view view(frame, meter);
+
+    // Exercise
+    view.set(0, white);
+    view.set(1, white);
+    view.set(1, rgb888{ 255, 0, 0 });
+
+    // Verify
+    expect(that % (10U + 60U + 20U) == meter.milliamps(10));
+    expect(that % 255 == meter.scale(10));
+  };
+
+  "power_meter accounts for apa102 global brightness"_test = [&]() {
+    // Setup
+    power_meter meter(model);
+    apa102_frame<1> frame{};
+    frame.pixels[0].brightness = 0b1110'0000 | 15;
+
+    // Exercise
+    apa102_frame_view(frame, meter).set(0, white);
+
+    // Verify
+    expect(that % (1U + 30U) == meter.milliamps(1));
+  };
+
+  "power_meter::scale() keeps full white within budget"_test = [&]() {
+    // Setup
+    power_meter meter(model);
+    ws2812b_spi_frame<20> frame{};
+    ws2812b_spi_frame_view view(frame, meter);
+
+    // Exercise
+    for (std::size_t i = 0; i < view.pixel_count(); i++) {
+      view.set(i, white);
+    }
+    auto const scale = meter.scale(view.pixel_count());
+
+    // Verify
+    // 20 pixels * (1mA + 60mA) = 1220mA, budget leaves 480mA for 1200mA
+    expect(that % 1220U == meter.milliamps(view.pixel_count()));
+    expect(that % 102 == scale);
+    expect(20U + 20U * 3U * scale_channel(255, scale) * 20U / 255U <= 500U);
+  };
+
+  "power_meter::scale() is zero when idle draw exceeds the budget"_test =
+    [&]() {
+      power_meter meter(model);
+      expect(that % 0 == meter.scale(600));
+    };
+
+  "power_meter::scale() never scales without a budget"_test = [&]() {
+    // Setup
+    power_meter meter(power_model{});
+    apa102_frame<4> frame{};
+
+    // Exercise
+    apa102_frame_view(frame, meter).fill(white);
+
+    // Verify
+    expect(that % 255 == meter.scale(4));
+  };
+
+  "metered views track bulk writes"_test = [&]() {
+    // Setup
+    power_meter filled(model);
+    power_meter composited(model);
+    power_meter ranged(model);
+    ws2812b_spi_frame<60> filled_frame{};
+    ws2812b_spi_frame<60> composited_frame{};
+    ws2812b_spi_frame<60> ranged_frame{};
+    std::array<rgba8888, 60> pixels{};
+    pixels.fill({ 255, 255, 255, 255 });
+    std::array<layer, 1> const layers = { { { .pixels = pixels } } };
+    ws2812b_spi_frame_view ranged_view(ranged_frame, ranged);
+    ranged_view.clear();
+
+    // Exercise
+    ws2812b_spi_frame_view(filled_frame, filled).fill(white);
+    compositor{}.composite(
+      layers, ws2812b_spi_frame_view(composited_frame, composited));
+    ranged_view.fill(10, 20, white);
+    ranged_view.fill(20, 20, rgb888{ 255, 0, 0 });
+
+    // Verify
+    expect(that % (60U + 60U * 60U) == filled.milliamps(60));
+    expect(that % (60U + 60U * 60U) == composited.milliamps(60));
+    expect(that % (60U + 10U * 60U + 20U * 20U) == ranged.milliamps(60));
+  };
+
+  "ws2812b::update(view) scales a metered view"_test = [&]() {
+    // Setup
+    hal::mock_write_only_spi spi;
+    ws2812b test_subject(spi);
+    power_meter meter(model);
+    ws2812b_spi_frame<60> frame{};
+    ws2812b_spi_frame_view view(frame, meter);
+    view.fill(white);
+
+    // Exercise
+    test_subject.update(view);
+
+    // Verify
+    auto const scale = meter.scale(view.pixel_count());
+    expect(that % 255 > scale);
+    expect(that % scale_channel(255, scale) ==
+           ws2812b_encoder<>::decode_channel(spi.write_record[0].data()));
+    expect(white == view.get(0));
+  };
+
+  "apa102::update(view) scales a metered view"_test = [&]() {
+    // Setup
+    hal::mock_write_only_spi spi;
+    apa102 test_subject(spi);
+    power_meter meter(model);
+    apa102_frame<20> frame{};
+    apa102_frame_view view(frame, meter);
+    view.fill(white);
+
+    // Exercise
+    test_subject.update(view);
+
+    // Verify
+    expect(that % scale_channel(255, 102) == spi.write_record[1][3]);
+    expect(that % 255 == frame.pixels[0].red);
+  };
+
+  "apa102::update(frame, meter) scales only when over budget"_test = [&]() {
+    // Setup
+    hal::mock_write_only_spi spi;
+    apa102 test_subject(spi);
+    power_meter meter(model);
+    apa102_frame<20> frame{};
+    apa102_frame_view view(frame, meter);
+    view.set(0, white);
+
+    // Exercise
+    test_subject.update(frame, meter);
+    for (std::size_t i = 1; i < view.pixel_count(); i++) {
+      view.set(i, white);
+    }
+    test_subject.update(frame, meter);
+
+    // Verify
+    // First update: start frame, all pixels, end frame
+    // Second update: start frame, 16 pixel batch, 4 pixel batch, end frame
+    expect(that % 7U == spi.write_record.size());
+    expect(that % 255 == spi.write_record[1][3]);
+    expect(that % scale_channel(255, 102) == spi.write_record[4][3]);
+    expect(that % 255 == frame.pixels[0].red);
+  };
+
+  "ws2812b::update(frame, meter) re-encodes scaled channels"_test = [&]() {
+    // Setup
+    hal::mock_write_only_spi spi;
+    ws2812b test_subject(spi);
+    power_meter meter(model);
+    ws2812b_spi_frame<20> frame{};
+    ws2812b_spi_frame<20> expected{};
+    ws2812b_spi_frame_view view(frame, meter);
+    for (std::size_t i = 0; i < view.pixel_count(); i++) {
+      view.set(i, white);
+      auto const scaled = scale_channel(255, 102);
+      ws2812b_spi_frame_view(expected).set(i, { scaled, scaled, scaled });
+    }
+
+    // Exercise
+    test_subject.update(frame, meter);
+
+    // Verify
+    std::vector<hal::byte> sent;
+    for (auto const& batch : spi.write_record) {
+      sent.insert(sent.end(), batch.begin(), batch.end());
+    }
+    expect(std::equal(sent.begin(), sent.end(), expected.data.begin()));
+    expect(that % expected.data.size() == sent.size());
+    expect(white == view.get(0));
+  };
+};
+}  // namespace hal::display
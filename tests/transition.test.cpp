@@ -0,0 +1,228 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <libhal-display/transition.hpp>
+
+#include <array>
+#include <chrono>
+
+#include <libhal-display/apa102.hpp>
+#include <libhal-display/ws2812b.hpp>
+
+#include <boost/ut.hpp>
+
+namespace hal::display {
+boost::ut::suite<"transition_test"> transition_test = [] {
+  using namespace boost::ut;
+  using namespace std::chrono_literals;
+
+  "ease() curves span the full range and never decrease"_test = []() {
+    for (auto curve : { easing::linear,
+                        easing::ease_in,
+                        easing::ease_out,
+                        easing::ease_in_out }) {
+      expect(that % 0U == ease(curve, 0));
+      expect(that % 255U == ease(curve, 255));
+      for (unsigned t = 1; t < 256; t++) {
+        auto const previous = ease(curve, static_cast<hal::byte>(t - 1));
+        auto const current = ease(curve, static_cast<hal::byte>(t));
+        expect(previous <= current) << "t:" << t;
+      }
+    }
+    static_assert(ease(easing::ease_in, 128) < 128);
+    static_assert(ease(easing::ease_out, 128) > 128);
+    static_assert(ease(easing::ease_in_out, 64) < 64);
+    static_assert(ease(easing::ease_in_out, 192) > 192);
+  };
+
+  "transition::progress() follows elapsed time"_test = []() {
+    constexpr transition linear({ .duration = 1s });
+
+    static_assert(0U == linear.progress(-5ms));
+    static_assert(0U == linear.progress(0ms));
+    static_assert(127U == linear.progress(500ms));
+    static_assert(255U == linear.progress(1s));
+    static_assert(255U == linear.progress(1h));
+  };
+
+  "crossfade between encoded ws2812b frames"_test = []() {
+    // Setup
+    ws2812b_spi_frame<3> from{};
+    ws2812b_spi_frame<3> to{};
+    ws2812b_spi_frame<3> output{};
+    ws2812b_spi_frame_view(from).fill({ 0, 0, 200 });
+    ws2812b_spi_frame_view(to).fill({ 200, 100, 0 });
+    transition fade({ .kind = transition_kind::crossfade, .duration = 1s });
+    ws2812b_spi_frame_view output_view(output);
+
+    // Exercise
+    auto const done_halfway = fade.render(ws2812b_spi_frame_view(from),
+                                          ws2812b_spi_frame_view(to),
+                                          output_view,
+                                          500ms);
+    auto const halfway = output_view.get(2);
+    auto const done_at_end = fade.render(ws2812b_spi_frame_view(from),
+                                         ws2812b_spi_frame_view(to),
+                                         output_view,
+                                         1s);
+
+    // Verify
+    expect(that % false == done_halfway);
+    expect(mix(rgb888{ 0, 0, 200 }, rgb888{ 200, 100, 0 }, 127) == halfway);
+    expect(that % true == done_at_end);
+    expect(to.data == output.data);
+  };
+
+  "wipe sweeps from the first pixel"_test = []() {
+    // Setup
+    apa102_frame<10> from{};
+    apa102_frame<10> to{};
+    apa102_frame<10> output{};
+    apa102_frame_view(from).fill({ 1, 1, 1 });
+    apa102_frame_view(to).fill({ 2, 2, 2 });
+    transition wipe({ .kind = transition_kind::wipe, .duration = 100ms });
+    apa102_frame_view output_view(output);
+
+    // Exercise
+    wipe.render(
+      apa102_frame_view(from), apa102_frame_view(to), output_view, 65ms);
+
+    // Verify
+    // 65ms of 100ms is a progress of 165, so 10 * 165 / 255 = 6 pixels
+    for (std::size_t i = 0; i < 10; i++) {
+      auto const expected = i < 6 ? rgb888{ 2, 2, 2 } : rgb888{ 1, 1, 1 };
+      expect(expected == output_view.get(i)) << "pixel:" << i;
+    }
+  };
+
+  "dissolve switches scattered pixels once each"_test = []() {
+    // Setup
+    apa102_frame<256> from{};
+    apa102_frame<256> to{};
+    apa102_frame<256> output{};
+    apa102_frame_view(to).fill({ 9, 9, 9 });
+    transition dissolve({ .kind = transition_kind::dissolve,
+                          .duration = 100ms,
+                          .seed = 1234 });
+    apa102_frame_view output_view(output);
+    std::array<bool, 256> switched_early{};
+
+    // Exercise & Verify
+    std::size_t previous_count = 0;
+    for (auto elapsed = 0ms; elapsed <= 100ms; elapsed += 10ms) {
+      dissolve.render(
+        apa102_frame_view(from), apa102_frame_view(to), output_view, elapsed);
+      std::size_t count = 0;
+      for (std::size_t i = 0; i < output.pixels.size(); i++) {
+        bool const switched = output.pixels[i].red == 9;
+        // Once a pixel switches to the new frame it stays there
+        expect(!switched_early[i] || switched) << "pixel:" << i;
+        switched_early[i] = switched;
+        count += switched ? 1 : 0;
+      }
+      expect(previous_count <= count);
+      if (elapsed == 50ms) {
+        // Roughly half of the pixels, and not a contiguous run
+        expect(count > 96U && count < 160U) << "count:" << count;
+        expect(!(switched_early[0] && switched_early[1] && switched_early[2] &&
+                 switched_early[3] && switched_early[4]));
+      }
+      previous_count = count;
+    }
+    expect(that % 256U == previous_count);
+  };
+  "crossfade in place steps the old frame to the new frame"_test = []() {
+    // Setup
+    ws2812b_spi_frame<3, rgbw_format> from{};
+    ws2812b_spi_frame<3, rgbw_format> to{};
+    rgbw8888 const old_color{ 0, 10, 200, 255 };
+    rgbw8888 const new_color{ 200, 100, 0, 0 };
+    ws2812b_spi_frame_view from_view(from);
+    ws2812b_spi_frame_view to_view(to);
+    from_view.fill(old_color);
+    to_view.fill(new_color);
+    transition fade({ .kind = transition_kind::crossfade,
+                      .curve = easing::ease_in_out,
+                      .duration = 1s });
+    auto const near = [](int p_expected, int p_actual) {
+      return p_expected - 1 <= p_actual && p_actual <= p_expected + 1;
+    };
+
+    // Exercise & Verify
+    for (auto elapsed = 0ms; elapsed < 1s; elapsed += 30ms) {
+      expect(!fade.render(from_view, to_view, from_view, elapsed));
+      auto const expected = mix(old_color, new_color, fade.progress(elapsed));
+      auto const actual = from_view.get(1);
+      // Rounding at each step stays within a count of the direct mix
+      expect(near(expected.red, actual.red) &&
+             near(expected.green, actual.green) &&
+             near(expected.blue, actual.blue) &&
+             near(expected.white, actual.white))
+        << "elapsed:" << elapsed.count();
+    }
+    expect(fade.render(from_view, to_view, from_view, 1s));
+    expect(to.data == from.data);
+  };
+
+  "crossfade in place starts over when time goes backwards"_test = []() {
+    // Setup
+    apa102_frame<1> from{};
+    apa102_frame<1> to{};
+    apa102_frame_view from_view(from);
+    apa102_frame_view to_view(to);
+    to_view.fill({ 255, 255, 255 });
+    transition fade({ .duration = 100ms });
+
+    // Exercise
+    fade.render(from_view, to_view, 100ms);
+    from_view.fill({ 0, 0, 0 });
+    fade.render(from_view, to_view, 50ms);
+
+    // Verify
+    expect(rgb888{ 127, 127, 127 } == from_view.get(0));
+  };
+
+  "wipe and dissolve in place match rendering to a third frame"_test = []() {
+    for (auto kind : { transition_kind::wipe, transition_kind::dissolve }) {
+      // Setup
+      apa102_frame<64> original{};
+      apa102_frame<64> from{};
+      apa102_frame<64> output{};
+      apa102_frame<64> to{};
+      apa102_frame_view(original).fill({ 1, 1, 1 });
+      apa102_frame_view(from).fill({ 1, 1, 1 });
+      apa102_frame_view(to).fill({ 2, 2, 2 });
+      apa102_frame_view from_view(from);
+      apa102_frame_view output_view(output);
+      transition in_place({ .kind = kind, .duration = 100ms, .seed = 7 });
+      transition separate({ .kind = kind, .duration = 100ms, .seed = 7 });
+
+      // Exercise & Verify
+      for (auto elapsed = 0ms; elapsed <= 100ms; elapsed += 7ms) {
+        in_place.render(from_view, apa102_frame_view(to), from_view, elapsed);
+        separate.render(apa102_frame_view(original),
+                        apa102_frame_view(to),
+                        output_view,
+                        elapsed);
+        for (std::size_t i = 0; i < 64; i++) {
+          expect(output_view.get(i) == from_view.get(i))
+            << "elapsed:" << elapsed.count() << " pixel:" << i;
+        }
+      }
+      expect(in_place.render(from_view, apa102_frame_view(to), 100ms));
+      expect(rgb888{ 2, 2, 2 } == from_view.get(63));
+    }
+  };
+};
+}  // namespace hal::display
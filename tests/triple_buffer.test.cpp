@@ -0,0 +1,145 @@
+// Copyright 2024 - 2025 Khalil Estell and the libhal contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <libhal-display/triple_buffer.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <new>
+#include <thread>
+
+#include <libhal-display/apa102.hpp>
+#include <libhal-display/ws2812b.hpp>
+
+#include <boost/ut.hpp>
+
+namespace hal::display {
+boost::ut::suite<"triple_buffer_test"> triple_buffer_test = [] {
+  using namespace boost::ut;
+
+  "triple_buffer of zeroed frames starts as all zero bytes"_test = []() {
+    // Setup
+    using buffer_type = triple_buffer<ws2812b_spi_frame<2>>;
+    alignas(buffer_type) std::array<hal::byte, sizeof(buffer_type)> storage{};
+    storage.fill(0xAA);
+
+    // Exercise
+    auto* buffer = new (storage.data()) buffer_type{};
+
+    // Verify
+    // All zero bytes lets the compiler place a static buffer in .bss
+    expect(std::ranges::all_of(storage,
+                               [](hal::byte p_byte) { return p_byte == 0; }));
+    ws2812b_spi_frame_view(buffer->back()).set(0, { 1, 2, 3 });
+    buffer->publish();
+    expect(buffer->acquire());
+    expect(rgb888{ 1, 2, 3 } == ws2812b_spi_frame_view(buffer->front()).get(0));
+    buffer->~buffer_type();
+  };
+
+  "acquire only swaps in published frames"_test = []() {
+    // Setup
+    triple_buffer<apa102_frame<2>> buffer;
+
+    // Exercise
+    auto const acquired_before_publish = buffer.acquire();
+    apa102_frame_view(buffer.back()).set(0, { 1, 2, 3 });
+    buffer.publish();
+    auto const acquired_after_publish = buffer.acquire();
+    auto const front_pixel = buffer.front().pixels[0];
+    auto const acquired_again = buffer.acquire();
+
+    // Verify
+    expect(that % false == acquired_before_publish);
+    expect(that % true == acquired_after_publish);
+    expect(that % 1U == front_pixel.red);
+    expect(that % 2U == front_pixel.green);
+    expect(that % 3U == front_pixel.blue);
+    expect(that % false == acquired_again);
+  };
+
+  "transmit side gets the latest of several published frames"_test = []() {
+    // Setup
+    std::array<apa102_frame<1>, 3> storage{};
+    triple_buffer<apa102_frame_view> buffer{
+      apa102_frame_view(storage[0]),
+      apa102_frame_view(storage[1]),
+      apa102_frame_view(storage[2]),
+    };
+
+    // Exercise
+    for (hal::byte i = 1; i <= 5; i++) {
+      buffer.back().set(0, { i, 0, 0 });
+      buffer.publish();
+    }
+    auto const acquired = buffer.acquire();
+
+    // Verify
+    expect(that % true == acquired);
+    expect(that % 5U == buffer.front().pixels()[0].red);
+    expect(buffer.back().pixels().data() != buffer.front().pixels().data());
+  };
+
+  "frames are never torn between threads"_test = []() {
+    // Setup
+    struct sequence_frame
+    {
+      std::array<std::uint32_t, 64> words{};
+    };
+    constexpr std::uint32_t last_sequence = 20000;
+    triple_buffer<sequence_frame> buffer;
+    std::atomic<bool> done = false;
+    bool torn = false;
+    bool out_of_order = false;
+    std::uint32_t frames_seen = 0;
+    std::uint32_t last_seen = 0;
+
+    // Exercise
+    std::thread renderer([&buffer, &done]() {
+      for (std::uint32_t sequence = 1; sequence <= last_sequence; sequence++) {
+        buffer.back().words.fill(sequence);
+        buffer.publish();
+      }
+      done = true;
+    });
+
+    while (true) {
+      // Read `done` first so the final acquire sees the last published frame
+      auto const finished = done.load();
+      if (buffer.acquire()) {
+        auto const& words = buffer.front().words;
+        auto const sequence = words[0];
+        torn = torn || std::ranges::any_of(words, [sequence](auto p_word) {
+                 return p_word != sequence;
+               });
+        out_of_order = out_of_order || sequence <= last_seen;
+        last_seen = sequence;
+        frames_seen++;
+      }
+      if (finished) {
+        break;
+      }
+    }
+    renderer.join();
+
+    // Verify
+    expect(that % false == torn);
+    expect(that % false == out_of_order);
+    expect(that % last_sequence == last_seen);
+    expect(that % 0U < frames_seen);
+  };
+};
+}  // namespace hal::display
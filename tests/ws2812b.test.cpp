@@ -13,3 +13,272 @@
 // limitations under the License.
 
 #include <libhal-display/ws2812b.hpp>
+
+#include <algorithm>
+#include <array>
+
+#include <libhal-util/mock/spi.hpp>
+
+#include <boost/ut.hpp>
+
+namespace hal::display {
+boost::ut::suite<"ws2812b_test"> ws2812b_test = [] {
+  using namespace boost::ut;
+
+  "ws2812b_spi_frame_size()"_test = []() {
+    static_assert(0U == ws2812b_spi_frame_size(0));
+    static_assert(12U == ws2812b_spi_frame_size(1));
+    static_assert(ws2812b_spi_frame<60>::array_length ==
+                  ws2812b_spi_frame_size(60));
+  };
+
+  "ws2812b_spi_frame_view(buffer, count)"_test = []() {
+    // Setup
+    std::array<hal::byte, ws2812b_spi_frame_size(10)> arena{};
+
+    // Exercise
+    ws2812b_spi_frame_view view(arena, 3);
+
+    // Verify
+    expect(that % 3U == view.pixel_count());
+    expect(that % ws2812b_spi_frame_size(3) == view.data().size());
+    expect(that % arena.data() == view.data().data());
+  };
+
+  "ws2812b_spi_frame_view(buffer, count) rejects small buffer"_test = []() {
+    std::array<hal::byte, ws2812b_spi_frame_size(2)> arena{};
+
+    expect(throws<hal::argument_out_of_domain>(
+      [&arena]() { ws2812b_spi_frame_view(arena, 3); }));
+  };
+
+  "ws2812b::update(ws2812b_spi_frame_view)"_test = []() {
+    // Setup
+    hal::mock_write_only_spi spi;
+    ws2812b test_subject(spi);
+    std::array<hal::byte, ws2812b_spi_frame_size(10)> arena{};
+    arena.fill(0x88);
+
+    // Exercise
+    test_subject.update(ws2812b_spi_frame_view(arena, 4));
+
+    // Verify
+    expect(that % 1U == spi.write_record.size());
+    expect(that % ws2812b_spi_frame_size(4) == spi.write_record[0].size());
+  };
+
+  "ws2812b_spi_frame_view::set()"_test = []() {
+    // Setup
+    ws2812b_spi_frame<2> frame{};
+    ws2812b_spi_frame_view view(frame);
+    std::array<hal::byte, 12> const expected = {
+      0x88, 0x88, 0x88, 0x8E,  // green 0x01
+      0xEE, 0xEE, 0xEE, 0xEE,  // red 0xFF
+      0xE8, 0xE8, 0xE8, 0xE8,  // blue 0xAA
+    };
+
+    // Exercise
+    view.set(1, rgb888{ .red = 0xFF, .green = 0x01, .blue = 0xAA });
+
+    // Verify
+    expect(std::equal(expected.begin(), expected.end(), &frame.data[12]));
+  };
+
+  "to_rgb(span<hsv>, ws2812b_spi_frame_view)"_test = []() {
+    // Setup
+    ws2812b_spi_frame<2> frame{};
+    ws2812b_spi_frame<2> expected{};
+    std::array<hsv, 3> const colors = { {
+      { .hue = 0, .saturation = 255, .value = 255 },
+      { .hue = 21845, .saturation = 255, .value = 255 },
+      { .hue = 43690, .saturation = 255, .value = 255 },
+    } };
+    ws2812b_spi_frame_view(expected).set(0, to_rgb(colors[0]));
+    ws2812b_spi_frame_view(expected).set(1, to_rgb(colors[1]));
+
+    // Exercise
+    to_rgb(colors, frame);
+
+    // Verify
+    expect(expected.data == frame.data);
+  };
+
+  "kelvin_to_rgb(span<uint16_t>, ws2812b_spi_frame<N, grbw_format>)"_test =
+    []() {
+      // Setup
+      ws2812b_spi_frame<2, grbw_format> frame{};
+      std::array<std::uint16_t, 2> const temperatures = { 2700, 6500 };
+
+      // Exercise
+      kelvin_to_rgb(temperatures, frame);
+
+      // Verify
+      auto const warm = kelvin_to_rgb(2700);
+      expect(rgbw8888{ warm.red, warm.green, warm.blue, 0 } ==
+             ws2812b_spi_frame_view(frame).get(0));
+    };
+
+  "pixel formats compute sizes at compile time"_test = []() {
+    static_assert(3U == grb_format::channel_count);
+    static_assert(!grb_format::has_white);
+    static_assert(4U == grbw_format::channel_count);
+    static_assert(grbw_format::has_white);
+    static_assert(16U == ws2812b_spi_frame_size<grbw_format>(1));
+    static_assert(16U * 30U ==
+                  ws2812b_spi_frame<30, grbw_format>::array_length);
+    static_assert(12U == ws2812b_spi_frame_size<rgb_format>(1));
+  };
+
+  "ws2812b_spi_frame_view<rgb_format>::set() sends red first"_test = []() {
+    // Setup
+    ws2812b_spi_frame<1, rgb_format> frame{};
+    std::array<hal::byte, 12> const expected = {
+      0xEE, 0xEE, 0xEE, 0xEE,  // red 0xFF
+      0x88, 0x88, 0x88, 0x8E,  // green 0x01
+      0xE8, 0xE8, 0xE8, 0xE8,  // blue 0xAA
+    };
+
+    // Exercise
+    ws2812b_spi_frame_view(frame).set(
+      0, rgb888{ .red = 0xFF, .green = 0x01, .blue = 0xAA });
+
+    // Verify
+    expect(expected == frame.data);
+  };
+
+  "ws2812b_spi_frame_view<grbw_format> round trips colors"_test = []() {
+    // Setup
+    ws2812b_spi_frame<2, grbw_format> frame{};
+    ws2812b_spi_frame_view view(frame);
+    rgbw8888 const color{ .red = 1, .green = 2, .blue = 3, .white = 0xF0 };
+
+    // Exercise
+    view.set(0, color);
+    view.set(1, rgb888{ .red = 4, .green = 5, .blue = 6 });
+
+    // Verify
+    expect(color == view.get(0));
+    expect(rgbw8888{ 4, 5, 6, 0 } == view.get(1));
+    // White is the last channel on the wire
+    expect(that % 0xEE == frame.data[12]);
+    expect(that % 0x88 == frame.data[15]);
+  };
+
+  "ws2812b::update(ws2812b_spi_frame<grbw_format>)"_test = []() {
+    // Setup
+    hal::mock_write_only_spi spi;
+    ws2812b test_subject(spi);
+    ws2812b_spi_frame<3, grbw_format> frame{};
+
+    // Exercise
+    test_subject.update(frame);
+
+    // Verify
+    expect(that % 1U == spi.write_record.size());
+    expect(that % 48U == spi.write_record[0].size());
+  };
+
+  "make_ws2812b_spi_frame() matches runtime encoding"_test = []() {
+    // Setup
+    static constexpr auto encoded = make_ws2812b_spi_frame(
+      std::array<rgb888, 2>{ { { 0xFF, 0x01, 0xAA }, { 0x12, 0x34, 0x56 } } });
+    static constexpr auto encoded_rgbw = make_ws2812b_spi_frame<grbw_format>(
+      std::array<rgbw8888, 1>{ { { 1, 2, 3, 4 } } });
+    ws2812b_spi_frame<2> expected{};
+    ws2812b_spi_frame_view(expected).set(0, { 0xFF, 0x01, 0xAA });
+    ws2812b_spi_frame_view(expected).set(1, { 0x12, 0x34, 0x56 });
+    hal::mock_write_only_spi spi;
+    ws2812b test_subject(spi);
+
+    // Exercise
+    test_subject.update(encoded.data);
+
+    // Verify
+    static_assert(16U == encoded_rgbw.data.size());
+    expect(expected.data == encoded.data);
+    expect(that % 1U == spi.write_record.size());
+    expect(std::equal(expected.data.begin(),
+                      expected.data.end(),
+                      spi.write_record[0].begin(),
+                      spi.write_record[0].end()));
+  };
+
+  "ws2812b_spi_frame_view::fill() matches set() for every length"_test = []() {
+    for (std::size_t count = 0; count <= 13; count++) {
+      // Setup
+      ws2812b_spi_frame<16> actual{};
+      ws2812b_spi_frame<16> expected{};
+      actual.data.fill(0x55);
+      expected.data.fill(0x55);
+      rgb888 const color{ 0x12, 0x34, 0x56 };
+      for (std::size_t i = 0; i < count; i++) {
+        ws2812b_spi_frame_view(expected).set(2 + i, color);
+      }
+
+      // Exercise
+      ws2812b_spi_frame_view(actual).fill(2, count, color);
+
+      // Verify
+      expect(expected.data == actual.data) << "count:" << count;
+    }
+  };
+
+  "ws2812b_spi_frame_view::clear() turns every pixel off"_test = []() {
+    // Setup
+    ws2812b_spi_frame<4, grbw_format> frame{};
+    ws2812b_spi_frame_view view(frame);
+    view.fill({ 1, 2, 3, 4 });
+
+    // Exercise
+    view.clear();
+
+    // Verify
+    for (std::size_t i = 0; i < view.pixel_count(); i++) {
+      expect(rgbw8888{} == view.get(i));
+    }
+    expect(std::ranges::all_of(
+      frame.data, [](hal::byte p_byte) { return p_byte == 0x88; }));
+  };
+
+  "ws2812b_spi_frame_view::gradient()"_test = []() {
+    // Setup
+    ws2812b_spi_frame<7> frame{};
+    ws2812b_spi_frame_view view(frame);
+    view.clear();
+
+    // Exercise
+    view.gradient(1, 5, { 0, 0, 255 }, { 200, 100, 55 });
+
+    // Verify
+    expect(rgb888{} == view.get(0));
+    expect(rgb888{ 0, 0, 255 } == view.get(1));
+    expect(rgb888{ 100, 50, 155 } == view.get(3));
+    expect(rgb888{ 200, 100, 55 } == view.get(5));
+    expect(rgb888{} == view.get(6));
+  };
+
+  "ws2812b_spi_frame_view fill helpers update a power meter"_test = []() {
+    // Setup
+    ws2812b_spi_frame<10> frame{};
+    power_meter meter({ .budget_milliamps = 500 });
+    ws2812b_spi_frame_view view(frame, meter);
+    auto const recount = [&view]() {
+      power_meter expected({ .budget_milliamps = 500 });
+      for (std::size_t i = 0; i < view.pixel_count(); i++) {
+        expected.exchange(0, power_meter::load(view.get(i)));
+      }
+      return expected.milliamps(view.pixel_count());
+    };
+
+    // Exercise & Verify
+    view.fill({ 255, 255, 255 });
+    expect(that % recount() == meter.milliamps(10));
+    view.fill(3, 4, { 10, 0, 0 });
+    expect(that % recount() == meter.milliamps(10));
+    view.gradient(5, 5, { 0, 0, 0 }, { 0, 200, 100 });
+    expect(that % recount() == meter.milliamps(10));
+    view.clear();
+    expect(that % 10U == meter.milliamps(10));
+  };
+};
+}  // namespace hal::display